@@ -0,0 +1,530 @@
+// Copyright 2022 DrSinIsIn (axel.gaillard.dev@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Times the building blocks of the library over the bundled corpora and prints one JSON object per line:
+//   SudokuSolver_Benchmarks [--filter text] [--corpora directory] [--min-time ms] [--samples n]
+// Each benchmark runs whole passes over a corpus until a sample lasts at least --min-time, and reports the
+// median over --samples samples, which keeps results comparable between runs and versions.
+
+#include "IO/PuzzleFileReader.h"
+#include "Solvers/AbstractSolver.h"
+#include "Solvers/BacktrackingSolver.h"
+#include "Solvers/BasicFishSolver.h"
+#include "Solvers/DancingLinksSolver.h"
+#include "Solvers/DifficultyGrading.h"
+#include "Solvers/FinnedFishSolver.h"
+#include "Solvers/HiddenTupleSolver.h"
+#include "Solvers/LockedCandidatesSolver.h"
+#include "Solvers/NakedSingleSolver.h"
+#include "Solvers/NakedTupleSolver.h"
+#include "Solvers/PuzzleGenerator.h"
+#include "Solvers/SolutionCounting.h"
+#include "Solvers/SolverPipeline.h"
+#include "Solvers/StrategyChain.h"
+#include "Solvers/Utility/SudokuDescriptor.h"
+#include "Sudoku.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace
+{
+    struct Options
+    {
+        std::string filter;
+        std::filesystem::path corporaDirectory = SUDOKU_SOLVER_CORPORA_DIR;
+        std::chrono::nanoseconds minSampleTime = std::chrono::milliseconds{ 20 };
+        std::size_t sampleCount = 5;
+    };
+
+    // Tiers of DifficultyGrader: singles; locked candidates and pairs; triples and fish; guessing
+    constexpr std::string_view difficulties[] = { "easy", "medium", "hard", "diabolical" };
+
+    // Keeps the compiler from optimizing away results that are otherwise unused
+    template<typename T>
+    void doNotOptimize(T const& value)
+    {
+#if defined(__GNUC__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+        static_cast<void>(*static_cast<unsigned char const volatile*>(static_cast<void const*>(&value)));
+#endif
+    }
+
+    // Solver run on the whole grid every time, as if it had no use for the changes since it last ran
+    template<typename Solver>
+    class IgnoringChanges : public Solver
+    {
+    public:
+        bool usesChanges() const override
+        {
+            return false;
+        }
+    };
+
+    class Harness
+    {
+    public:
+        explicit Harness(Options const& options)
+            : m_options{ options }
+        {}
+
+        // prepare runs untimed before every pass, run is one timed pass doing operationCount operations
+        template<typename Prepare, typename Run>
+        void measure(std::string_view name
+                   , std::string_view grid
+                   , std::string_view corpus
+                   , std::size_t operationCount
+                   , Prepare&& prepare
+                   , Run&& run) const
+        {
+            std::string const fullName = std::string{ name } + '/' + std::string{ grid } + '/'
+                                       + std::string{ corpus };
+            if ((operationCount == 0) || (fullName.find(m_options.filter) == std::string::npos))
+            {
+                return;
+            }
+
+            // Warm-up pass, also telling how many passes a sample needs
+            prepare();
+            std::chrono::nanoseconds const warmUpTime = timePass(run);
+            std::chrono::nanoseconds const passTime = std::max(warmUpTime, std::chrono::nanoseconds{ 1 });
+            std::size_t const passCount = std::max<std::size_t>(1, m_options.minSampleTime / passTime);
+
+            std::vector<double> nanosecondsPerOperation;
+            for (std::size_t sample = 0; sample < m_options.sampleCount; ++sample)
+            {
+                std::chrono::nanoseconds total{};
+                for (std::size_t pass = 0; pass < passCount; ++pass)
+                {
+                    prepare();
+                    total += timePass(run);
+                }
+
+                nanosecondsPerOperation.push_back(static_cast<double>(total.count())
+                                                / static_cast<double>(passCount * operationCount));
+            }
+
+            std::ranges::sort(nanosecondsPerOperation);
+            double const median = nanosecondsPerOperation[nanosecondsPerOperation.size() / 2];
+
+            std::cout << "{\"benchmark\":\"" << name << "\""
+                      << ",\"grid\":\"" << grid << "\""
+                      << ",\"corpus\":\"" << corpus << "\""
+                      << ",\"operations\":" << (passCount * operationCount)
+                      << ",\"samples\":" << nanosecondsPerOperation.size()
+                      << ",\"ns_per_op\":" << median
+                      << ",\"min_ns_per_op\":" << nanosecondsPerOperation.front()
+                      << ",\"max_ns_per_op\":" << nanosecondsPerOperation.back()
+                      << ",\"ops_per_s\":" << (1e9 / median)
+                      << "}\n" << std::flush;
+        }
+
+    private:
+        template<typename Run>
+        static std::chrono::nanoseconds timePass(Run& run)
+        {
+            auto const start = std::chrono::steady_clock::now();
+            run();
+            return std::chrono::steady_clock::now() - start;
+        }
+
+        Options const& m_options;
+    };
+
+    template<typename Grid>
+    class GridBenchmarks
+    {
+    public:
+        using Descriptor = SudokuDescriptor<Grid>;
+        using SolverPointer = std::unique_ptr<AbstractSolver<Grid, Descriptor>>;
+
+        GridBenchmarks(Harness const& harness
+                     , std::string_view gridName
+                     , std::string_view corpus
+                     , std::vector<Grid> puzzles)
+            : m_harness{ harness }
+            , m_gridName{ gridName }
+            , m_corpus{ corpus }
+            , m_puzzles{ std::move(puzzles) }
+        {
+            for (auto const& puzzle : m_puzzles)
+            {
+                m_descriptors.emplace_back(puzzle);
+            }
+        }
+
+        void run()
+        {
+            measureDescriptorOperations();
+
+            measureSolveOnce<NakedSingleSolver<Grid>>("solveOnce/NakedSingleSolver");
+            measureSolveOnce<HiddenSingleSolver<Grid>>("solveOnce/HiddenSingleSolver");
+            measureSolveOnce<NakedTupleSolver<2, Grid>>("solveOnce/NakedTupleSolver<2>");
+            measureSolveOnce<NakedTupleSolver<3, Grid>>("solveOnce/NakedTupleSolver<3>");
+            measureSolveOnce<HiddenTupleSolver<2, Grid>>("solveOnce/HiddenTupleSolver<2>");
+            measureSolveOnce<HiddenTupleSolver<3, Grid>>("solveOnce/HiddenTupleSolver<3>");
+            measureSolveOnce<LockedCandidatesSolver<Grid>>("solveOnce/LockedCandidatesSolver");
+            measureSolveOnce<BasicFishSolver<2, Grid>>("solveOnce/BasicFishSolver<2>");
+            measureSolveOnce<BasicFishSolver<3, Grid>>("solveOnce/BasicFishSolver<3>");
+            measureSolveOnce<FinnedFishSolver<2, Grid>>("solveOnce/FinnedFishSolver<2>");
+            measureSolveOnce<FinnedFishSolver<3, Grid>>("solveOnce/FinnedFishSolver<3>");
+            measureSolveOnce<FrankenFishSolver<2, Grid>>("solveOnce/FrankenFishSolver<2>");
+
+            auto solver = std::make_unique<SolverPipeline<Grid>>();
+            solver->template add<NakedSingleSolver<Grid>>();
+            solver->template add<HiddenSingleSolver<Grid>>();
+            solver->template add<LockedCandidatesSolver<Grid>>();
+            solver->template add<HiddenTupleSolver<2, Grid>>();
+            solver->template add<BasicFishSolver<2, Grid>>();
+            solver->template add<BacktrackingSolver<Grid>>();
+            measureSolveOnce("fullSolve", std::move(solver));
+            measureTrailedSolve();
+            measureValueMajorLayout();
+            measureStrategySolve();
+
+            // Same logic, with the search done on the exact cover matrix of the candidates left
+            auto exactCover = std::make_unique<SolverPipeline<Grid>>();
+            exactCover->template add<NakedSingleSolver<Grid>>();
+            exactCover->template add<HiddenSingleSolver<Grid>>();
+            exactCover->template add<LockedCandidatesSolver<Grid>>();
+            exactCover->template add<HiddenTupleSolver<2, Grid>>();
+            exactCover->template add<BasicFishSolver<2, Grid>>();
+            exactCover->template add<DancingLinksSolver<Grid>>();
+            measureSolveOnce("fullSolve/DancingLinksSolver", std::move(exactCover));
+            measureSolveOnce<DancingLinksSolver<Grid>>("solveOnce/DancingLinksSolver");
+            measureUniqueness();
+            measureGrading();
+
+            // Same strategies, dispatched at run time and at compile time
+            auto pipeline = std::make_unique<SolverPipeline<Grid>>();
+            pipeline->template add<NakedSingleSolver<Grid>>();
+            pipeline->template add<HiddenSingleSolver<Grid>>();
+            pipeline->template add<LockedCandidatesSolver<Grid>>();
+            measureSolveOnce("logicSolve/SolverPipeline", std::move(pipeline));
+            measureSolveOnce<StrategyChain<NakedSingleSolver<Grid>
+                                         , HiddenSingleSolver<Grid>
+                                         , LockedCandidatesSolver<Grid>>>("logicSolve/StrategyChain");
+        }
+
+    private:
+        void measureDescriptorOperations()
+        {
+            auto const nothing = [] {};
+
+            m_harness.measure("descriptorFromGrid", m_gridName, m_corpus, m_puzzles.size(), nothing, [this]
+            {
+                for (auto const& puzzle : m_puzzles)
+                {
+                    Descriptor const descriptor{ puzzle };
+                    doNotOptimize(descriptor);
+                }
+            });
+
+            m_harness.measure("gridFromDescriptor", m_gridName, m_corpus, m_descriptors.size(), nothing, [this]
+            {
+                for (auto const& descriptor : m_descriptors)
+                {
+                    Grid const grid = descriptor;
+                    doNotOptimize(grid);
+                }
+            });
+
+            m_harness.measure("isValid", m_gridName, m_corpus, m_puzzles.size(), nothing, [this]
+            {
+                for (auto const& puzzle : m_puzzles)
+                {
+                    bool const isValid = puzzle.isValid();
+                    doNotOptimize(isValid);
+                }
+            });
+        }
+
+        template<typename Solver>
+        void measureSolveOnce(std::string_view name)
+        {
+            measureSolveOnce(name, std::make_unique<Solver>());
+        }
+
+        // From the descriptor of every puzzle as read, restored before each pass
+        void measureSolveOnce(std::string_view name, SolverPointer solver)
+        {
+            measureSolveOnce(name, *solver, m_descriptors);
+        }
+
+        template<typename Solver, typename SolverDescriptor>
+        void measureSolveOnce(std::string_view name, std::vector<SolverDescriptor> const& descriptors)
+        {
+            Solver solver;
+            measureSolveOnce(name, solver, descriptors);
+        }
+
+        template<typename SolverDescriptor>
+        void measureSolveOnce(std::string_view name
+                            , AbstractSolver<Grid, SolverDescriptor>& solver
+                            , std::vector<SolverDescriptor> const& descriptors)
+        {
+            std::vector<SolverDescriptor> working = descriptors;
+
+            m_harness.measure(name
+                            , m_gridName
+                            , m_corpus
+                            , working.size()
+                            , [&] { std::ranges::copy(descriptors, working.begin()); }
+                            , [&]
+                              {
+                                  for (auto& descriptor : working)
+                                  {
+                                      bool const progressed = solver.solveOnce(descriptor);
+                                      doNotOptimize(progressed);
+                                  }
+                              });
+        }
+
+        // From the grids as read, as when validating puzzles before publishing them
+        void measureUniqueness()
+        {
+            SolutionCounter<Grid> counter;
+            m_harness.measure("hasUniqueSolution", m_gridName, m_corpus, m_puzzles.size(), [] {}, [&]
+            {
+                for (auto const& puzzle : m_puzzles)
+                {
+                    bool const isUnique = counter.hasUniqueSolution(puzzle);
+                    doNotOptimize(isUnique);
+                }
+            });
+        }
+
+        void measureGrading()
+        {
+            DifficultyGrader<Grid> grader;
+            m_harness.measure("grade", m_gridName, m_corpus, m_puzzles.size(), [] {}, [&]
+            {
+                for (auto const& puzzle : m_puzzles)
+                {
+                    Grade const grade = grader.grade(puzzle);
+                    doNotOptimize(grade);
+                }
+            });
+        }
+
+        // fullSolve's strategies on descriptors recording their changes, so that guesses are rolled back, not copied
+        void measureTrailedSolve()
+        {
+            using TrailedDescriptor = TrailedSudokuDescriptor<Grid>;
+            std::vector<TrailedDescriptor> const descriptors(m_puzzles.begin(), m_puzzles.end());
+
+            SolverPipeline<Grid, TrailedDescriptor> solver;
+            solver.template add<NakedSingleSolver<Grid, TrailedDescriptor>>();
+            solver.template add<HiddenSingleSolver<Grid, TrailedDescriptor>>();
+            solver.template add<LockedCandidatesSolver<Grid, TrailedDescriptor>>();
+            solver.template add<HiddenTupleSolver<2, Grid, TrailedDescriptor>>();
+            solver.template add<BasicFishSolver<2, Grid, TrailedDescriptor>>();
+            solver.template add<BacktrackingSolver<Grid, TrailedDescriptor>>();
+            measureSolveOnce("fullSolve/TrailedSudokuDescriptor", solver, descriptors);
+        }
+
+        // The strategies reading candidates per value and fullSolve on value-major descriptors, to compare with the
+        // default cell-major layout and pick one per grid size
+        void measureValueMajorLayout()
+        {
+            using ValueMajorDescriptor = SudokuDescriptor<Grid, StaticBitset, ValueMajorLayout>;
+            std::vector<ValueMajorDescriptor> const descriptors(m_puzzles.begin(), m_puzzles.end());
+
+            measureSolveOnce<NakedSingleSolver<Grid, ValueMajorDescriptor>>(
+                "solveOnce/NakedSingleSolver/ValueMajorLayout", descriptors);
+            measureSolveOnce<HiddenSingleSolver<Grid, ValueMajorDescriptor>>(
+                "solveOnce/HiddenSingleSolver/ValueMajorLayout", descriptors);
+            measureSolveOnce<LockedCandidatesSolver<Grid, ValueMajorDescriptor>>(
+                "solveOnce/LockedCandidatesSolver/ValueMajorLayout", descriptors);
+            measureSolveOnce<BasicFishSolver<2, Grid, ValueMajorDescriptor>>(
+                "solveOnce/BasicFishSolver<2>/ValueMajorLayout", descriptors);
+            measureSolveOnce<BasicFishSolver<3, Grid, ValueMajorDescriptor>>(
+                "solveOnce/BasicFishSolver<3>/ValueMajorLayout", descriptors);
+
+            SolverPipeline<Grid, ValueMajorDescriptor> solver;
+            solver.template add<NakedSingleSolver<Grid, ValueMajorDescriptor>>();
+            solver.template add<HiddenSingleSolver<Grid, ValueMajorDescriptor>>();
+            solver.template add<LockedCandidatesSolver<Grid, ValueMajorDescriptor>>();
+            solver.template add<HiddenTupleSolver<2, Grid, ValueMajorDescriptor>>();
+            solver.template add<BasicFishSolver<2, Grid, ValueMajorDescriptor>>();
+            solver.template add<BacktrackingSolver<Grid, ValueMajorDescriptor>>();
+            measureSolveOnce("fullSolve/ValueMajorLayout", solver, descriptors);
+        }
+
+        // Logic strategies only, without backtracking, up to triples and swordfish: singles, tuples and fish handed the
+        // changes since they last ran, and the same strategies run on the whole grid every time
+        void measureStrategySolve()
+        {
+            auto logic = std::make_unique<SolverPipeline<Grid>>();
+            logic->template add<NakedSingleSolver<Grid>>();
+            logic->template add<HiddenSingleSolver<Grid>>();
+            logic->template add<LockedCandidatesSolver<Grid>>();
+            logic->template add<NakedTupleSolver<2, Grid>>();
+            logic->template add<HiddenTupleSolver<2, Grid>>();
+            logic->template add<BasicFishSolver<2, Grid>>();
+            logic->template add<NakedTupleSolver<3, Grid>>();
+            logic->template add<HiddenTupleSolver<3, Grid>>();
+            logic->template add<BasicFishSolver<3, Grid>>();
+            measureSolveOnce("strategySolve", std::move(logic));
+
+            auto fullPasses = std::make_unique<SolverPipeline<Grid>>();
+            fullPasses->template add<IgnoringChanges<NakedSingleSolver<Grid>>>();
+            fullPasses->template add<IgnoringChanges<HiddenSingleSolver<Grid>>>();
+            fullPasses->template add<LockedCandidatesSolver<Grid>>();
+            fullPasses->template add<IgnoringChanges<NakedTupleSolver<2, Grid>>>();
+            fullPasses->template add<IgnoringChanges<HiddenTupleSolver<2, Grid>>>();
+            fullPasses->template add<IgnoringChanges<BasicFishSolver<2, Grid>>>();
+            fullPasses->template add<IgnoringChanges<NakedTupleSolver<3, Grid>>>();
+            fullPasses->template add<IgnoringChanges<HiddenTupleSolver<3, Grid>>>();
+            fullPasses->template add<IgnoringChanges<BasicFishSolver<3, Grid>>>();
+            measureSolveOnce("strategySolve/IgnoringChanges", std::move(fullPasses));
+        }
+
+        Harness const& m_harness;
+        std::string_view m_gridName;
+        std::string_view m_corpus;
+        std::vector<Grid> m_puzzles;
+        std::vector<Descriptor> m_descriptors;
+    };
+
+    // Fresh puzzles from a fixed seed, each pass generating the same ones
+    template<typename Grid>
+    void measureGeneration(Harness const& harness, std::string_view gridName, std::size_t puzzleCount)
+    {
+        PuzzleGenerator<Grid> generator;
+        for (auto const symmetry : { ClueSymmetry::None, ClueSymmetry::Rotational })
+        {
+            std::string_view const name = (symmetry == ClueSymmetry::None) ? "generate" : "generate/Rotational";
+            harness.measure(name, gridName, "random", puzzleCount, [] {}, [&]
+            {
+                for (std::size_t i = 0; i < puzzleCount; ++i)
+                {
+                    generator.seed(i);
+                    Grid const puzzle = generator.generate(symmetry);
+                    doNotOptimize(puzzle);
+                }
+            });
+        }
+    }
+
+    template<typename Grid>
+    void runGridBenchmarks(Harness const& harness, Options const& options, std::string_view gridName)
+    {
+        measureGeneration<Grid>(harness, gridName, (Grid::maxValue <= 9) ? 20 : 2);
+
+        for (auto const difficulty : difficulties)
+        {
+            std::string const fileName = std::string{ gridName } + '_' + std::string{ difficulty } + ".txt";
+            auto const path = options.corporaDirectory / fileName;
+            if (!std::filesystem::exists(path))
+            {
+                std::cerr << "Missing corpus " << path << '\n';
+                continue;
+            }
+
+            GridBenchmarks<Grid>{ harness, gridName, difficulty, PuzzleFileReader<Grid>{ path }.readAll() }.run();
+        }
+    }
+
+    // Parses the whole of value as a number, leaving result alone on failure
+    bool parseNumber(std::string_view value, std::size_t& result)
+    {
+        char const* const valueEnd = value.data() + value.size();
+        auto const [end, error] = std::from_chars(value.data(), valueEnd, result);
+        return (error == std::errc{}) && (end == valueEnd);
+    }
+
+    std::optional<Options> parseArguments(int argc, char** argv)
+    {
+        Options options;
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string_view const argument = argv[i];
+            if ((i + 1) >= argc)
+            {
+                return std::nullopt;
+            }
+
+            if (argument == "--filter")
+            {
+                options.filter = argv[++i];
+            }
+            else if (argument == "--corpora")
+            {
+                options.corporaDirectory = argv[++i];
+            }
+            else if (argument == "--min-time")
+            {
+                std::string_view const value = argv[++i];
+                // Beyond this the sample time no longer fits in nanoseconds
+                auto const maxMilliseconds = static_cast<std::size_t>(
+                    std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::nanoseconds::max()).count());
+                std::size_t milliseconds = 0;
+                if (!parseNumber(value, milliseconds) || (milliseconds > maxMilliseconds))
+                {
+                    std::cerr << "--min-time expects a number of milliseconds up to " << maxMilliseconds
+                              << ", got '" << value << "'\n";
+                    return std::nullopt;
+                }
+
+                options.minSampleTime = std::chrono::milliseconds{ milliseconds };
+            }
+            else if (argument == "--samples")
+            {
+                std::string_view const value = argv[++i];
+                if (!parseNumber(value, options.sampleCount) || (options.sampleCount == 0))
+                {
+                    std::cerr << "--samples expects a positive number, got '" << value << "'\n";
+                    return std::nullopt;
+                }
+            }
+            else
+            {
+                return std::nullopt;
+            }
+        }
+
+        return options;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::optional<Options> const options = parseArguments(argc, argv);
+    if (!options)
+    {
+        std::cerr << "Usage: SudokuSolver_Benchmarks"
+                  << " [--filter text] [--corpora directory] [--min-time ms] [--samples n]\n";
+        return 2;
+    }
+
+    try
+    {
+        Harness const harness{ *options };
+        runGridBenchmarks<Sudoku9>(harness, *options, "9x9");
+        runGridBenchmarks<Sudoku<4, 4>>(harness, *options, "16x16");
+    }
+    catch (std::exception const& exception)
+    {
+        std::cerr << exception.what() << '\n';
+        return 1;
+    }
+
+    return 0;
+}
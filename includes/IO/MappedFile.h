@@ -0,0 +1,53 @@
+// Copyright 2022 DrSinIsIn (axel.gaillard.dev@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+// Whole file mapped in memory. Uses mmap on POSIX systems; elsewhere the file is read into (and written back
+// from) a buffer, which keeps the same interface at the cost of a copy. Throws std::system_error on failure.
+class MappedFile
+{
+public:
+    // Read-only mapping of an existing file
+    static MappedFile openForReading(std::filesystem::path const& path);
+
+    // Writable mapping of a file created (or truncated) to exactly size bytes
+    static MappedFile createForWriting(std::filesystem::path const& path, std::size_t size);
+
+    MappedFile() = default;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    ~MappedFile();
+
+    std::span<char const> bytes() const noexcept
+    {
+        return { m_data, m_size };
+    }
+
+    // Empty for read-only mappings
+    std::span<char> writableBytes() noexcept
+    {
+        return { m_isWritable ? m_data : nullptr, m_isWritable ? m_size : 0 };
+    }
+
+    // Makes written bytes durable; also done on destruction, where errors are ignored
+    void flush();
+
+private:
+    void close() noexcept;
+
+    char* m_data = nullptr;
+    std::size_t m_size = 0;
+    bool m_isWritable = false;
+
+    // Only used without mmap
+    std::filesystem::path m_path;
+    std::vector<char> m_buffer;
+};
@@ -0,0 +1,132 @@
+// Copyright 2022 DrSinIsIn (axel.gaillard.dev@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "MappedFile.h"
+#include "PuzzleFormat.h"
+
+// Parses a one-puzzle-per-line file straight from its memory mapping. Empty lines are skipped and both "\n"
+// and "\r\n" line endings are accepted; any other malformed line throws std::invalid_argument.
+template<typename Grid>
+class PuzzleFileReader
+{
+public:
+    using Alphabet = PuzzleAlphabet<Grid>;
+
+    explicit PuzzleFileReader(std::filesystem::path const& path)
+        : m_file{ MappedFile::openForReading(path) }
+        , m_text{ m_file.bytes() }
+    {}
+
+    // Puzzles already in memory (e.g. read from a pipe), which must outlive the reader
+    explicit PuzzleFileReader(std::string_view text)
+        : m_text{ text.data(), text.size() }
+    {}
+
+    // Next puzzle into target, which may be the grid itself or anything built from it (e.g. a
+    // SudokuDescriptor). Returns false at the end of the file.
+    template<typename Target>
+        requires std::constructible_from<Target, Grid const&>
+    bool next(Target& target)
+    {
+        std::optional<std::string_view> const line = nextLine();
+        if (!line)
+        {
+            return false;
+        }
+
+        if constexpr (std::same_as<Target, Grid>)
+        {
+            decodeLine(*line, target);
+        }
+        else
+        {
+            Grid grid;
+            decodeLine(*line, grid);
+            target = Target{ grid };
+        }
+
+        return true;
+    }
+
+    // Every remaining puzzle
+    std::vector<Grid> readAll()
+    {
+        std::vector<Grid> result;
+        result.reserve(remainingByteCount() / (Grid::cellCount + 1));
+
+        Grid grid;
+        while (next(grid))
+        {
+            result.push_back(grid);
+        }
+
+        return result;
+    }
+
+    // 1-based line of the last puzzle read
+    std::size_t lineNumber() const noexcept
+    {
+        return m_lineNumber;
+    }
+
+private:
+    std::size_t remainingByteCount() const noexcept
+    {
+        return m_text.size() - m_position;
+    }
+
+    std::optional<std::string_view> nextLine()
+    {
+        while (m_position < m_text.size())
+        {
+            char const* const begin = m_text.data() + m_position;
+            auto const* const newLine = static_cast<char const*>(std::memchr(begin, '\n', remainingByteCount()));
+            std::size_t const length = (newLine != nullptr) ? static_cast<std::size_t>(newLine - begin)
+                                                            : remainingByteCount();
+
+            m_position += length + 1;
+            ++m_lineNumber;
+
+            std::string_view line{ begin, length };
+            if (line.ends_with('\r'))
+            {
+                line.remove_suffix(1);
+            }
+
+            if (!line.empty())
+            {
+                return line;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    void decodeLine(std::string_view line, Grid& grid) const
+    {
+        if (!Alphabet::decode(line, grid))
+        {
+            throw std::invalid_argument{ "Malformed puzzle at line " + std::to_string(m_lineNumber) };
+        }
+    }
+
+    MappedFile m_file;
+    std::span<char const> m_text;
+    std::size_t m_position = 0;
+    std::size_t m_lineNumber = 0;
+};
@@ -0,0 +1,51 @@
+// Copyright 2022 DrSinIsIn (axel.gaillard.dev@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <filesystem>
+
+#include "MappedFile.h"
+#include "PuzzleFormat.h"
+
+// Writes puzzles one per line into a mapped file sized for puzzleCount of them up front. Every puzzle has its
+// own fixed slot, so threads may write distinct indices concurrently (e.g. straight from solveBatch workers).
+template<typename Grid>
+class PuzzleFileWriter
+{
+public:
+    using Alphabet = PuzzleAlphabet<Grid>;
+
+    static constexpr std::size_t lineSize = Grid::cellCount + 1;
+
+    PuzzleFileWriter(std::filesystem::path const& path, std::size_t puzzleCount)
+        : m_file{ MappedFile::createForWriting(path, puzzleCount * lineSize) }
+        , m_puzzleCount{ puzzleCount }
+    {}
+
+    std::size_t size() const noexcept
+    {
+        return m_puzzleCount;
+    }
+
+    void write(std::size_t index, Grid const& grid) noexcept
+    {
+        assert(index < m_puzzleCount);
+        char* const line = m_file.writableBytes().data() + (index * lineSize);
+        Alphabet::encode(grid, line);
+        line[Grid::cellCount] = '\n';
+    }
+
+    void flush()
+    {
+        m_file.flush();
+    }
+
+private:
+    MappedFile m_file;
+    std::size_t m_puzzleCount;
+};
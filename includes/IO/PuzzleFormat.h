@@ -0,0 +1,114 @@
+// Copyright 2022 DrSinIsIn (axel.gaillard.dev@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace details
+{
+    // Decodes count characters among "0123456789." into values, with '.' read as 0. Returns false as soon as
+    // another character is met. Vectorized with SSE2 when available.
+    bool decodeDigits(char const* text, std::size_t count, std::uint8_t* values) noexcept;
+}
+
+// One character per cell, '0' or '.' for blanks:
+// - up to 9 values: digits
+// - up to 16 values: 1-9 then A-G (so 10 is 'A')
+// - more: A-Y, 'A' being 1
+// Letters are accepted in both cases and written upper case.
+template<typename Grid>
+struct PuzzleAlphabet
+{
+    static_assert(Grid::maxValue <= 26, "No single character alphabet for this grid size");
+
+    static constexpr std::uint8_t invalid = 0xFF;
+
+    static constexpr bool isDigitsOnly = (Grid::maxValue <= 9);
+
+    static constexpr char valueToChar(std::size_t value) noexcept
+    {
+        if (value == 0)
+        {
+            return '.';
+        }
+
+        if constexpr (Grid::maxValue <= 16)
+        {
+            return (value <= 9) ? static_cast<char>('0' + value) : static_cast<char>('A' + value - 10);
+        }
+        else
+        {
+            return static_cast<char>('A' + value - 1);
+        }
+    }
+
+    // Character to value, invalid for characters outside the alphabet
+    static constexpr std::array<std::uint8_t, 256> decodeTable = []
+    {
+        std::array<std::uint8_t, 256> result{};
+        result.fill(invalid);
+        result[static_cast<unsigned char>('.')] = 0;
+        result[static_cast<unsigned char>('0')] = 0;
+
+        for (std::size_t value = 1; value <= Grid::maxValue; ++value)
+        {
+            char const c = valueToChar(value);
+            result[static_cast<unsigned char>(c)] = static_cast<std::uint8_t>(value);
+            if ((c >= 'A') && (c <= 'Z'))
+            {
+                result[static_cast<unsigned char>(c - 'A' + 'a')] = static_cast<std::uint8_t>(value);
+            }
+        }
+
+        return result;
+    }();
+
+    // Reads exactly Grid::cellCount characters into grid, returns false on any character outside the alphabet
+    static bool decode(std::string_view text, Grid& grid) noexcept
+    {
+        if (text.size() != Grid::cellCount)
+        {
+            return false;
+        }
+
+        std::array<std::uint8_t, Grid::cellCount> values;
+        if constexpr (isDigitsOnly)
+        {
+            if (!details::decodeDigits(text.data(), text.size(), values.data())
+                || std::ranges::any_of(values, [](auto value) { return value > Grid::maxValue; }))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            std::uint8_t invalidFound = 0;
+            for (std::size_t i = 0; i < Grid::cellCount; ++i)
+            {
+                values[i] = decodeTable[static_cast<unsigned char>(text[i])];
+                invalidFound |= static_cast<std::uint8_t>(values[i] == invalid);
+            }
+
+            if (invalidFound != 0)
+            {
+                return false;
+            }
+        }
+
+        std::ranges::copy(values, grid.begin());
+        return true;
+    }
+
+    // Writes exactly Grid::cellCount characters
+    static void encode(Grid const& grid, char* text) noexcept
+    {
+        std::ranges::transform(grid, text, [](auto value) { return valueToChar(value); });
+    }
+};
@@ -5,15 +5,33 @@
 
 #pragma once
 
+#include "Utility/CandidateChanges.h"
 #include "Utility/SudokuDescriptor.h"
 
-template<typename Grid>
+template<typename Grid, typename Descriptor = SudokuDescriptor<Grid>>
 class AbstractSolver
 {
 public:
-    using GridDescriptor = SudokuDescriptor<Grid>;
+    using GridDescriptor = Descriptor;
     using Bitset = typename GridDescriptor::Bitset;
     using Integer = typename Grid::Integer;
+    using Changes = CandidateChanges<Grid>;
+
+    virtual ~AbstractSolver() = default;
 
     virtual bool solveOnce(GridDescriptor& gridDescriptor) = 0;
+
+    // Same as solveOnce, given what changed since this solver last ran on the grid and found nothing more: what the
+    // changes can't affect may be skipped. Only called when usesChanges() is true.
+    virtual bool solveChanged(GridDescriptor& gridDescriptor, Changes const& changes)
+    {
+        static_cast<void>(changes);
+        return solveOnce(gridDescriptor);
+    }
+
+    // Whether solveChanged does less than solveOnce, in which case pipelines keep track of the changes for it
+    virtual bool usesChanges() const
+    {
+        return false;
+    }
 };
@@ -0,0 +1,178 @@
+// Copyright 2022 DrSinIsIn (axel.gaillard.dev@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+
+#include "AbstractSolver.h"
+#include "HiddenTupleSolver.h"
+#include "NakedSingleSolver.h"
+#include "SolverPipeline.h"
+#include "Utility/CandidateTrail.h"
+
+
+// Last resort strategy: guesses a value for the unsolved cell with the fewest possibilities, propagates it
+// with the given strategies and backtracks on contradictions. solveOnce only modifies the descriptor when a
+// solution has been found, in which case the descriptor is left filled with it.
+// Descriptors that can record their changes to a CandidateTrail are searched in place, each guess being undone by
+// rolling the trail back; the others are copied at every guess.
+template<typename Grid, typename Descriptor = SudokuDescriptor<Grid>>
+class BacktrackingSolver : public AbstractSolver<Grid, Descriptor>
+{
+public:
+    using GridDescriptor = typename AbstractSolver<Grid, Descriptor>::GridDescriptor;
+    using Bitset = typename AbstractSolver<Grid, Descriptor>::Bitset;
+    using Integer = typename AbstractSolver<Grid, Descriptor>::Integer;
+
+    // Propagates guesses with naked and hidden singles
+    BacktrackingSolver()
+        : m_ownedPropagator{ makeSinglesPipeline() }
+        , m_propagator{ m_ownedPropagator.get() }
+    {}
+
+    // propagator must outlive this solver and must not contain it
+    explicit BacktrackingSolver(AbstractSolver<Grid, Descriptor>& propagator)
+        : m_propagator{ &propagator }
+    {}
+
+    bool solveOnce(GridDescriptor& gridDescriptor) override
+    {
+        if (gridDescriptor.isFilled())
+        {
+            return false;
+        }
+
+        GridDescriptor searchDescriptor{ gridDescriptor };
+        if constexpr (isTrailed)
+        {
+            searchDescriptor.setTrail(&m_trail);
+        }
+
+        bool const found = search(searchDescriptor);
+        if constexpr (isTrailed)
+        {
+            searchDescriptor.setTrail(nullptr);
+            m_trail.clear();
+        }
+
+        if (!found)
+        {
+            return false;
+        }
+
+        gridDescriptor = searchDescriptor;
+        return true;
+    }
+
+private:
+    static constexpr bool isTrailed = requires(GridDescriptor& descriptor, CandidateTrail* trail)
+    {
+        descriptor.setTrail(trail);
+    };
+
+    std::unique_ptr<AbstractSolver<Grid, Descriptor>> m_ownedPropagator;
+    AbstractSolver<Grid, Descriptor>* m_propagator = nullptr;
+    CandidateTrail m_trail; // Kept between searches for its capacity
+
+    static std::unique_ptr<AbstractSolver<Grid, Descriptor>> makeSinglesPipeline()
+    {
+        auto pipeline = std::make_unique<SolverPipeline<Grid, Descriptor>>();
+        pipeline->template add<NakedSingleSolver<Grid, Descriptor>>();
+        pipeline->template add<HiddenSingleSolver<Grid, Descriptor>>();
+        return pipeline;
+    }
+
+    bool search(GridDescriptor& gridDescriptor)
+    {
+        m_propagator->solveOnce(gridDescriptor);
+
+        // Dead ends are dropped before guessing any further, and filled grids without contradiction are solutions
+        if (gridDescriptor.isContradiction())
+        {
+            return false;
+        }
+
+        if (gridDescriptor.isFilled())
+        {
+            return true;
+        }
+
+        auto const cell = findMostConstrainedCell(gridDescriptor);
+        if (!cell)
+        {
+            return false;
+        }
+
+        for (Integer value = 1; value <= Grid::maxValue; ++value)
+        {
+            if (!gridDescriptor.possibilities().test(GridDescriptor::bitIndex(*cell, value)))
+            {
+                continue;
+            }
+
+            if constexpr (isTrailed)
+            {
+                auto const mark = m_trail.mark();
+                gridDescriptor.setValue(*cell, value);
+                if (search(gridDescriptor))
+                {
+                    return true;
+                }
+                m_trail.rollback(mark);
+            }
+            else
+            {
+                GridDescriptor guess{ gridDescriptor };
+                guess.setValue(*cell, value);
+                if (search(guess))
+                {
+                    gridDescriptor = guess;
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    // Unsolved cell with the fewest possibilities, or nothing if some unsolved cell has none left
+    static std::optional<std::size_t> findMostConstrainedCell(GridDescriptor const& gridDescriptor)
+    {
+        Bitset const missingValuesPossibilities = gridDescriptor.possibilities()
+                                                & gridDescriptor.missingValuesMask();
+
+        std::size_t bestCell = 0;
+        std::size_t bestCount = Grid::maxValue + 1;
+        for (std::size_t cell = 0; cell < Grid::cellCount; ++cell)
+        {
+            auto const cellMask = gridDescriptor.cellMask(cell);
+            if ((gridDescriptor.missingValuesMask() & cellMask).none())
+            {
+                continue;
+            }
+
+            auto const count = (missingValuesPossibilities & cellMask).count();
+            if (count == 0)
+            {
+                return std::nullopt;
+            }
+
+            if (count < bestCount)
+            {
+                bestCell = cell;
+                bestCount = count;
+                if (count <= 2)
+                {
+                    break;
+                }
+            }
+        }
+
+        return bestCell;
+    }
+};
@@ -5,94 +5,205 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <bit>
 #include <cstddef>
-#include <numeric>
+#include <span>
 
 #include "AbstractSolver.h"
+#include "Utility/GridTopology.h"
 #include "Utility/MathUtils.h"
+#include "Utility/SetBitIterator.h"
 
-template<std::size_t size, typename Grid>
-    requires (size > 0) && (size < Grid::columnCount / 2)
-class BasicFishSolver : public AbstractSolver<Grid>
+// Fish of a given size, searched one value at a time: size base lines (rows, then columns) whose candidates for the
+// value all lie in size cover lines of the other orientation remove the value from the rest of the cover lines.
+template<std::size_t size, typename Grid, typename Descriptor = SudokuDescriptor<Grid>>
+    requires (size > 0) && (size < Grid::columnCount)
+class BasicFishSolver : public AbstractSolver<Grid, Descriptor>
 {
 public:
-    using GridDescriptor = typename AbstractSolver<Grid>::GridDescriptor;
-    using Bitset = typename AbstractSolver<Grid>::Bitset;
-    using Integer = typename AbstractSolver<Grid>::Integer;
+    using GridDescriptor = typename AbstractSolver<Grid, Descriptor>::GridDescriptor;
+    using Bitset = typename AbstractSolver<Grid, Descriptor>::Bitset;
+    using Integer = typename AbstractSolver<Grid, Descriptor>::Integer;
+    using Changes = typename AbstractSolver<Grid, Descriptor>::Changes;
+    using Topology = GridTopology<Grid>;
 
     bool solveOnce(GridDescriptor& gridDescriptor) override
     {
-        using Indices = std::array<std::size_t, size>;
+        bool found = false;
 
-        constexpr Indices firstIndexCombination = []
+        for (Integer value = 1; value <= Grid::maxValue; ++value)
         {
-            Indices result;
-            std::iota(result.begin(), result.end(), 0);
-            return result;
-        }();
+            found |= solveBasicFishFor(gridDescriptor, value);
+        }
 
-        Indices rowIndices = firstIndexCombination;
-        Indices colIndices = firstIndexCombination;
+        return found;
+    }
 
+    // Fish only depend on the candidates of their value
+    bool solveChanged(GridDescriptor& gridDescriptor, Changes const& changes) override
+    {
         bool found = false;
-        do
+
+        for (auto const bit : setBits(changes.values))
+        {
+            found |= solveBasicFishFor(gridDescriptor, static_cast<Integer>(bit + 1));
+        }
+
+        return found;
+    }
+
+    bool usesChanges() const override
+    {
+        return true;
+    }
+
+private:
+    // One bit per line of an orientation, or per cell of a line
+    using Lines = typename Topology::HousePositions;
+
+    static constexpr Lines bit(std::size_t index) noexcept
+    {
+        return static_cast<Lines>(Lines{ 1 } << index);
+    }
+
+    using Combinations = MathUtils::BoundedUnionCombinations<size, Lines>;
+
+    // Candidates for one value in the lines of one orientation. The localIndex-th cell of row y is (localIndex, y)
+    // and the one of column x is (x, localIndex), so that a line's positions are the indices of the crossing lines.
+    struct FishCandidates
+    {
+        Integer value{};
+        std::size_t coverHouse{};
+        std::array<Lines, Grid::maxValue> linePositions{};
+        std::array<std::size_t, Grid::maxValue> baseLines{};
+        std::array<Lines, Grid::maxValue> baseLinePositions{}; // Positions of each base line
+        std::size_t baseLineCount{};
+    };
+
+    bool solveBasicFishFor(GridDescriptor& descriptor, Integer value) const
+    {
+        bool hasSolved = solveBasicFishFor(descriptor, value, Topology::rowHouse(0), Topology::columnHouse(0));
+        hasSolved |= solveBasicFishFor(descriptor, value, Topology::columnHouse(0), Topology::rowHouse(0));
+        return hasSolved;
+    }
+
+    bool solveBasicFishFor(GridDescriptor& descriptor
+                         , Integer value
+                         , std::size_t baseHouse
+                         , std::size_t coverHouse) const
+    {
+        FishCandidates candidates = gatherCandidates(descriptor, value, baseHouse, coverHouse);
+        if (candidates.baseLineCount < size)
         {
-            Bitset rowsMask;
+            return false;
+        }
+
+        bool hasSolved = false;
 
-            for (auto i : rowIndices)
+        // Base lines whose candidates spread over more than size cover lines can't be part of a fish
+        std::span<Lines const> const positions{ candidates.baseLinePositions.data(), candidates.baseLineCount };
+        for (auto const& fish : Combinations{ positions, size })
+        {
+            if (static_cast<std::size_t>(std::popcount(fish.unionMask)) == size)
             {
-                rowsMask |= gridDescriptor.rowMask(i);
+                hasSolved |= eliminateFromCover(descriptor, candidates, fish);
             }
+        }
 
-            do
-            {
-                Bitset colsMask;
+        return hasSolved;
+    }
+
+    static FishCandidates gatherCandidates(GridDescriptor const& descriptor
+                                         , Integer value
+                                         , std::size_t baseHouse
+                                         , std::size_t coverHouse)
+    {
+        FishCandidates candidates{ value, coverHouse };
 
-                for (auto i : colIndices)
+        auto const valueCells = descriptor.valueCells(value);
+        for (std::size_t line = 0; line < Grid::maxValue; ++line)
+        {
+            Lines positions{};
+            bool isPlaced = false;
+            for (std::size_t position = 0; auto cell : Topology::houseCells[baseHouse + line])
+            {
+                if (valueCells.test(cell))
                 {
-                    colsMask |= gridDescriptor.columnMask(i);
+                    positions |= bit(position);
+                    isPlaced |= !descriptor.missingValuesMask().test(GridDescriptor::bitIndex(cell, value));
                 }
+                ++position;
+            }
 
-                found |= solveBasicFish(gridDescriptor, rowsMask, colsMask);
+            candidates.linePositions[line] = positions;
 
-            } while (MathUtils::nextCombination<Grid::maxValue>(colIndices));
-        } while (MathUtils::nextCombination<Grid::maxValue>(rowIndices));
+            // Lines with a single candidate are singles, only fish of size 1, and lines with more than size can't be
+            // in a fish
+            auto const positionCount = static_cast<std::size_t>(std::popcount(positions));
+            if (!isPlaced && (positionCount >= std::min<std::size_t>(size, 2)) && (positionCount <= size))
+            {
+                candidates.baseLines[candidates.baseLineCount] = line;
+                candidates.baseLinePositions[candidates.baseLineCount] = positions;
+                ++candidates.baseLineCount;
+            }
+        }
 
-        return found;
+        return candidates;
     }
 
-private:
-    bool solveBasicFish(GridDescriptor& gridDescriptor, Bitset const& rowsMask, Bitset const& colsMask) const
+    // The value is in the cover lines only at their crossings with the base lines
+    static bool eliminateFromCover(GridDescriptor& descriptor
+                                 , FishCandidates& candidates
+                                 , typename Combinations::Combination const& fish)
     {
-        bool found = false;
+        Lines baseLines{};
+        for (auto index : fish.indices)
+        {
+            baseLines |= bit(candidates.baseLines[index]);
+        }
 
-        for (Integer value = 1; value <= Grid::maxValue; ++value)
+        bool hasSolved = false;
+
+        for (std::size_t line = 0; line < Grid::maxValue; ++line)
         {
-            Bitset const possibleCells = gridDescriptor.possibilitiesForValue(value);
-            Bitset const inRows = possibleCells & rowsMask;
-            Bitset const inCols = possibleCells & colsMask;
-            Bitset const possibleFish = inRows & inCols;
-            if (possibleFish.none() || (possibleFish == (inRows | inCols)))
+            Lines& positions = candidates.linePositions[line];
+            if (((baseLines & bit(line)) != 0) || ((positions & fish.unionMask) == 0))
             {
                 continue;
             }
 
-            if (inRows == possibleFish)
-            {
-                gridDescriptor.possibilities() &= ~(inCols ^ possibleFish);
-                found = true;
-            }
-            else if (inCols == possibleFish)
+            for (Lines removed = positions & fish.unionMask; removed != 0; removed &= static_cast<Lines>(removed - 1))
             {
-                gridDescriptor.possibilities() &= ~(inRows ^ possibleFish);
-                found = true;
+                auto const cell = Topology::houseCells[candidates.coverHouse + std::countr_zero(removed)][line];
+
+                // Placed values are left alone, removing them would only hide a contradiction
+                if (descriptor.missingValuesMask().test(GridDescriptor::bitIndex(cell, candidates.value)))
+                {
+                    descriptor.possibilities().reset(GridDescriptor::bitIndex(cell, candidates.value));
+                    hasSolved = true;
+                }
             }
+
+            positions &= static_cast<Lines>(~fish.unionMask);
         }
 
-        return found;
+        // Later combinations see the lines as they are now
+        for (std::size_t i = 0; i < candidates.baseLineCount; ++i)
+        {
+            candidates.baseLinePositions[i] = candidates.linePositions[candidates.baseLines[i]];
+        }
+
+        return hasSolved;
     }
 };
 
-template<typename Grid>
-using XWingSolver = BasicFishSolver<2, Grid>;
+template<typename Grid, typename Descriptor = SudokuDescriptor<Grid>>
+using XWingSolver = BasicFishSolver<2, Grid, Descriptor>;
+
+template<typename Grid, typename Descriptor = SudokuDescriptor<Grid>>
+using SwordfishSolver = BasicFishSolver<3, Grid, Descriptor>;
+
+template<typename Grid, typename Descriptor = SudokuDescriptor<Grid>>
+using JellyfishSolver = BasicFishSolver<4, Grid, Descriptor>;
@@ -0,0 +1,335 @@
+// Copyright 2022 DrSinIsIn (axel.gaillard.dev@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <span>
+
+#include "Utility/BatchDescriptor.h"
+#include "Utility/SudokuDescriptor.h"
+
+
+// Runs naked singles, hidden singles and locked candidates in lockstep on every lane of a BatchDescriptor.
+// Each rule is the one of NakedSingleSolver, HiddenSingleSolver and LockedCandidatesSolver applied to a value
+// plane, so a lane reaches the same fixpoint as a SolverPipeline of those three strategies would.
+template<typename Grid, std::size_t laneCount = 8>
+class BatchSolver
+{
+public:
+    using Descriptor = BatchDescriptor<Grid, laneCount>;
+    using Integer = typename Descriptor::Integer;
+    using Topology = typename Descriptor::Topology;
+    using Word = typename Descriptor::Word;
+    using Lanes = typename Descriptor::Lanes;
+    using Plane = typename Descriptor::Plane;
+    using LaneFlags = std::array<bool, laneCount>;
+
+    static constexpr std::size_t planeWordCount = Descriptor::planeWordCount;
+
+    // One round of every rule; returns which lanes changed
+    LaneFlags propagateOnce(Descriptor& descriptor) const
+    {
+        Descriptor const before = descriptor;
+
+        solveNakedSingles(descriptor);
+        solveHiddenSingles(descriptor);
+        solveLockedCandidates(descriptor);
+
+        return changedLanes(before, descriptor);
+    }
+
+    // Rounds until no lane changes anymore
+    void propagate(Descriptor& descriptor) const
+    {
+        LaneFlags changed{};
+        do
+        {
+            changed = propagateOnce(descriptor);
+        } while (std::ranges::any_of(changed, std::identity{}));
+    }
+
+    // Streams puzzles through the lanes: a lane is retired into results as soon as it is filled or stuck, and
+    // immediately refilled with the next puzzle. results[i] is the propagated descriptor of puzzles[i].
+    template<typename ResultDescriptor = SudokuDescriptor<Grid>>
+    void solve(std::span<Grid const> puzzles, std::span<ResultDescriptor> results) const
+    {
+        assert(results.size() >= puzzles.size());
+
+        Descriptor descriptor;
+        std::array<std::size_t, laneCount> puzzleOfLane{};
+        std::size_t nextPuzzle = 0;
+        std::size_t busyLaneCount = 0;
+
+        auto const refill = [&](std::size_t lane)
+        {
+            if (nextPuzzle < puzzles.size())
+            {
+                puzzleOfLane[lane] = nextPuzzle;
+                descriptor.load(lane, SudokuDescriptor<Grid>{ puzzles[nextPuzzle++] });
+                ++busyLaneCount;
+            }
+        };
+
+        for (std::size_t lane = 0; lane < laneCount; ++lane)
+        {
+            refill(lane);
+        }
+
+        std::array<bool, laneCount> isBusy{};
+        for (std::size_t lane = 0; lane < busyLaneCount; ++lane)
+        {
+            isBusy[lane] = true;
+        }
+
+        while (busyLaneCount > 0)
+        {
+            LaneFlags const changed = propagateOnce(descriptor);
+
+            for (std::size_t lane = 0; lane < laneCount; ++lane)
+            {
+                if (!isBusy[lane] || (changed[lane] && !descriptor.isFilled(lane)))
+                {
+                    continue;
+                }
+
+                results[puzzleOfLane[lane]] = descriptor.template store<ResultDescriptor>(lane);
+                descriptor.clear(lane);
+                --busyLaneCount;
+
+                std::size_t const busyBefore = busyLaneCount;
+                refill(lane);
+                isBusy[lane] = busyLaneCount > busyBefore;
+            }
+        }
+    }
+
+private:
+    static constexpr Word laneMask(bool condition) noexcept
+    {
+        return Descriptor::laneMask(condition);
+    }
+
+    static LaneFlags changedLanes(Descriptor const& before, Descriptor const& after)
+    {
+        Lanes difference{};
+        auto const accumulate = [&difference](Plane const& a, Plane const& b)
+        {
+            for (std::size_t w = 0; w < planeWordCount; ++w)
+            {
+                for (std::size_t lane = 0; lane < laneCount; ++lane)
+                {
+                    difference[lane] |= a[w][lane] ^ b[w][lane];
+                }
+            }
+        };
+
+        for (Integer value = 1; value <= Grid::maxValue; ++value)
+        {
+            accumulate(before.candidates(value), after.candidates(value));
+        }
+        accumulate(before.missingCells(), after.missingCells());
+
+        LaneFlags result{};
+        for (std::size_t lane = 0; lane < laneCount; ++lane)
+        {
+            result[lane] = difference[lane] != 0;
+        }
+
+        return result;
+    }
+
+    // Cells of a house's plane holding at least one bit of plane, per lane
+    static Lanes intersects(Plane const& plane, std::size_t house)
+    {
+        auto const& housePlane = Descriptor::housePlanes[house];
+
+        Lanes result{};
+        for (std::size_t w = 0; w < planeWordCount; ++w)
+        {
+            for (std::size_t lane = 0; lane < laneCount; ++lane)
+            {
+                result[lane] |= plane[w][lane] & housePlane.word(w);
+            }
+        }
+
+        return result;
+    }
+
+    // Same as NakedSingleSolver: every unsolved cell with a single candidate gets placed, and its value is
+    // removed from the rest of its houses
+    static void solveNakedSingles(Descriptor& descriptor)
+    {
+        Plane once{};
+        Plane twice{};
+        for (Integer value = 1; value <= Grid::maxValue; ++value)
+        {
+            Plane const& candidates = descriptor.candidates(value);
+            for (std::size_t w = 0; w < planeWordCount; ++w)
+            {
+                for (std::size_t lane = 0; lane < laneCount; ++lane)
+                {
+                    twice[w][lane] |= once[w][lane] & candidates[w][lane];
+                    once[w][lane] |= candidates[w][lane];
+                }
+            }
+        }
+
+        Plane& missingCells = descriptor.missingCells();
+        Plane singles{};
+        for (std::size_t w = 0; w < planeWordCount; ++w)
+        {
+            for (std::size_t lane = 0; lane < laneCount; ++lane)
+            {
+                singles[w][lane] = missingCells[w][lane] & once[w][lane] & ~twice[w][lane];
+                missingCells[w][lane] &= ~singles[w][lane];
+            }
+        }
+
+        for (Integer value = 1; value <= Grid::maxValue; ++value)
+        {
+            Plane& candidates = descriptor.candidates(value);
+
+            Plane valueSingles{};
+            for (std::size_t w = 0; w < planeWordCount; ++w)
+            {
+                for (std::size_t lane = 0; lane < laneCount; ++lane)
+                {
+                    valueSingles[w][lane] = singles[w][lane] & candidates[w][lane];
+                }
+            }
+
+            for (std::size_t house = 0; house < Topology::houseCount; ++house)
+            {
+                Lanes const hits = intersects(valueSingles, house);
+                auto const& housePlane = Descriptor::housePlanes[house];
+                for (std::size_t w = 0; w < planeWordCount; ++w)
+                {
+                    for (std::size_t lane = 0; lane < laneCount; ++lane)
+                    {
+                        Word const impossibilities = housePlane.word(w) & ~valueSingles[w][lane];
+                        candidates[w][lane] &= ~(impossibilities & laneMask(hits[lane] != 0));
+                    }
+                }
+            }
+        }
+    }
+
+    // Same as HiddenSingleSolver: a value with a single possible cell in a house removes every other
+    // candidate from that cell
+    static void solveHiddenSingles(Descriptor& descriptor)
+    {
+        std::array<Plane, Grid::maxValue> hiddenSingles{};
+        Plane allHiddenSingles{};
+
+        for (Integer value = 1; value <= Grid::maxValue; ++value)
+        {
+            Plane const& candidates = descriptor.candidates(value);
+            Plane& valueHiddenSingles = hiddenSingles[value - 1];
+
+            for (std::size_t house = 0; house < Topology::houseCount; ++house)
+            {
+                auto const& housePlane = Descriptor::housePlanes[house];
+
+                Lanes counts{};
+                for (std::size_t w = 0; w < planeWordCount; ++w)
+                {
+                    for (std::size_t lane = 0; lane < laneCount; ++lane)
+                    {
+                        counts[lane] += static_cast<Word>(std::popcount(candidates[w][lane] & housePlane.word(w)));
+                    }
+                }
+
+                for (std::size_t w = 0; w < planeWordCount; ++w)
+                {
+                    for (std::size_t lane = 0; lane < laneCount; ++lane)
+                    {
+                        Word const single = candidates[w][lane] & housePlane.word(w) & laneMask(counts[lane] == 1);
+                        valueHiddenSingles[w][lane] |= single;
+                        allHiddenSingles[w][lane] |= single;
+                    }
+                }
+            }
+        }
+
+        for (Integer value = 1; value <= Grid::maxValue; ++value)
+        {
+            Plane& candidates = descriptor.candidates(value);
+            Plane const& valueHiddenSingles = hiddenSingles[value - 1];
+            for (std::size_t w = 0; w < planeWordCount; ++w)
+            {
+                for (std::size_t lane = 0; lane < laneCount; ++lane)
+                {
+                    candidates[w][lane] &= ~(allHiddenSingles[w][lane] & ~valueHiddenSingles[w][lane]);
+                }
+            }
+        }
+    }
+
+    // Same as LockedCandidatesSolver, for every (value, box, line crossing the box)
+    static void solveLockedCandidates(Descriptor& descriptor)
+    {
+        for (Integer value = 1; value <= Grid::maxValue; ++value)
+        {
+            Plane& candidates = descriptor.candidates(value);
+            for (std::size_t box = 0; box < Grid::boxCount; ++box)
+            {
+                auto const [boxX, boxY] = Grid::cellToCoordinates(Grid::boxIndexToTopLeftCell(box));
+                std::size_t const boxHouse = Topology::boxHouse(box);
+
+                for (std::size_t j = 0; j < Grid::boxWidth; ++j)
+                {
+                    solveLockedCandidatesFor(candidates, boxHouse, Topology::columnHouse(boxX + j));
+                }
+
+                for (std::size_t j = 0; j < Grid::boxHeight; ++j)
+                {
+                    solveLockedCandidatesFor(candidates, boxHouse, Topology::rowHouse(boxY + j));
+                }
+            }
+        }
+    }
+
+    static void solveLockedCandidatesFor(Plane& candidates, std::size_t houseA, std::size_t houseB)
+    {
+        auto const& planeA = Descriptor::housePlanes[houseA];
+        auto const& planeB = Descriptor::housePlanes[houseB];
+
+        // Per lane: A != B, A & B != 0, and A or B entirely within A & B
+        Lanes aDiffersFromB{};
+        Lanes cross{};
+        Lanes aOutsideCross{};
+        Lanes bOutsideCross{};
+        for (std::size_t w = 0; w < planeWordCount; ++w)
+        {
+            for (std::size_t lane = 0; lane < laneCount; ++lane)
+            {
+                Word const a = candidates[w][lane] & planeA.word(w);
+                Word const b = candidates[w][lane] & planeB.word(w);
+                aDiffersFromB[lane] |= a ^ b;
+                cross[lane] |= a & b;
+                aOutsideCross[lane] |= a & ~b;
+                bOutsideCross[lane] |= b & ~a;
+            }
+        }
+
+        for (std::size_t w = 0; w < planeWordCount; ++w)
+        {
+            Word const eliminated = planeA.word(w) ^ planeB.word(w);
+            for (std::size_t lane = 0; lane < laneCount; ++lane)
+            {
+                bool const isLocked = (aDiffersFromB[lane] != 0)
+                                    & (cross[lane] != 0)
+                                    & ((aOutsideCross[lane] == 0) | (bOutsideCross[lane] == 0));
+                candidates[w][lane] &= ~(eliminated & laneMask(isLocked));
+            }
+        }
+    }
+};
@@ -0,0 +1,234 @@
+// Copyright 2022 DrSinIsIn (axel.gaillard.dev@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "AbstractSolver.h"
+#include "BacktrackingSolver.h"
+#include "HiddenTupleSolver.h"
+#include "LockedCandidatesSolver.h"
+#include "NakedSingleSolver.h"
+#include "SolverPipeline.h"
+
+struct BatchOptions
+{
+    // 0 uses every hardware thread
+    std::size_t threadCount = 0;
+};
+
+namespace details
+{
+    // Puzzle indices [begin, end) owned by one worker: the owner pops from the front while thieves take the
+    // back half. Each range sits on its own cache line so that workers do not share them.
+    struct alignas(64) WorkRange
+    {
+        std::mutex mutex;
+        std::size_t begin = 0;
+        std::size_t end = 0;
+
+        std::optional<std::size_t> pop()
+        {
+            std::scoped_lock lock{ mutex };
+            if (begin == end)
+            {
+                return std::nullopt;
+            }
+
+            return begin++;
+        }
+
+        // Takes the back half of the remaining indices, at least one
+        bool stealInto(WorkRange& thief)
+        {
+            std::scoped_lock lock{ mutex, thief.mutex };
+            std::size_t const remaining = end - begin;
+            if (remaining == 0)
+            {
+                return false;
+            }
+
+            std::size_t const stolen = (remaining + 1) / 2;
+            thief.begin = end - stolen;
+            thief.end = end;
+            end -= stolen;
+            return true;
+        }
+    };
+
+    class WorkStealingRanges
+    {
+    public:
+        // Splits [0, itemCount) evenly over the workers
+        WorkStealingRanges(std::size_t itemCount, std::size_t workerCount)
+            : m_ranges{ std::make_unique<WorkRange[]>(workerCount) }
+            , m_workerCount{ workerCount }
+            , m_unclaimedCount{ itemCount }
+        {
+            for (std::size_t worker = 0; worker < workerCount; ++worker)
+            {
+                m_ranges[worker].begin = (itemCount * worker) / workerCount;
+                m_ranges[worker].end = (itemCount * (worker + 1)) / workerCount;
+            }
+        }
+
+        // Next item for the worker, stolen from another one once its own range is exhausted; nullopt once all
+        // items have been handed out. A scan can miss items moving between two other workers, or lose the ones it
+        // stole to a thief before popping them, so the worker only gives up once no item is left unclaimed.
+        std::optional<std::size_t> next(std::size_t worker)
+        {
+            WorkRange& own = m_ranges[worker];
+            while (!m_stopped.load(std::memory_order_acquire)
+                && (m_unclaimedCount.load(std::memory_order_acquire) > 0))
+            {
+                if (auto const item = own.pop())
+                {
+                    m_unclaimedCount.fetch_sub(1, std::memory_order_acq_rel);
+                    return item;
+                }
+
+                bool stole = false;
+                for (std::size_t i = 1; (i < m_workerCount) && !stole; ++i)
+                {
+                    stole = m_ranges[(worker + i) % m_workerCount].stealInto(own);
+                }
+
+                if (!stole)
+                {
+                    std::this_thread::yield();
+                }
+            }
+
+            return std::nullopt;
+        }
+
+        // No item is handed out anymore, the ones left unclaimed are dropped
+        void stop() noexcept
+        {
+            m_stopped.store(true, std::memory_order_release);
+        }
+
+    private:
+        std::unique_ptr<WorkRange[]> m_ranges;
+        std::size_t m_workerCount;
+        std::atomic<std::size_t> m_unclaimedCount; // Items not popped yet, wherever they are
+        std::atomic<bool> m_stopped = false;
+    };
+
+    // Calls work(worker, ranges) once per worker, the calling thread being worker 0, ranges handing out the items
+    // [0, itemCount) to the workers. Returns once every worker is done. When work throws, on any worker, the other
+    // workers get no more items and the first exception thrown is rethrown here once they are all done.
+    template<typename Work>
+    void runWorkers(std::size_t itemCount, BatchOptions const& options, Work const& work)
+    {
+        std::size_t const hardwareThreadCount = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+        std::size_t const requestedThreadCount = (options.threadCount == 0) ? hardwareThreadCount
+                                                                            : options.threadCount;
+        std::size_t const workerCount = std::clamp<std::size_t>(requestedThreadCount
+                                                              , 1
+                                                              , std::max<std::size_t>(itemCount, 1));
+
+        WorkStealingRanges ranges{ itemCount, workerCount };
+
+        std::mutex exceptionMutex;
+        std::exception_ptr exception;
+        auto const guardedWork = [&](std::size_t worker)
+        {
+            try
+            {
+                work(worker, ranges);
+            }
+            catch (...)
+            {
+                ranges.stop();
+                std::scoped_lock lock{ exceptionMutex };
+                if (!exception)
+                {
+                    exception = std::current_exception();
+                }
+            }
+        };
+
+        {
+            std::vector<std::jthread> threads;
+            threads.reserve(workerCount - 1);
+            for (std::size_t worker = 1; worker < workerCount; ++worker)
+            {
+                threads.emplace_back(guardedWork, worker);
+            }
+
+            guardedWork(0);
+        }
+
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+}
+
+// Solves every puzzle with the strategies returned by makeSolver, which is called once per worker thread,
+// possibly concurrently, since solvers may hold scratch state. out[i] receives the grid reached from
+// puzzles[i], with 0 left in the cells that could not be solved. Returns the number of filled grids.
+template<typename Grid, typename Descriptor = SudokuDescriptor<Grid>, typename SolverFactory>
+std::size_t solveBatch(std::span<Grid const> puzzles
+                     , std::span<Grid> out
+                     , BatchOptions const& options
+                     , SolverFactory makeSolver)
+{
+    assert(out.size() >= puzzles.size());
+
+    std::atomic<std::size_t> filledCount = 0;
+
+    details::runWorkers(puzzles.size(), options, [&](std::size_t worker, details::WorkStealingRanges& ranges)
+    {
+        std::unique_ptr<AbstractSolver<Grid, Descriptor>> const solver = makeSolver();
+        std::size_t workerFilledCount = 0;
+
+        while (auto const index = ranges.next(worker))
+        {
+            Descriptor descriptor{ puzzles[*index] };
+            while (!descriptor.isFilled() && solver->solveOnce(descriptor))
+            {
+            }
+
+            workerFilledCount += descriptor.isFilled() ? 1 : 0;
+            out[*index] = descriptor;
+        }
+
+        filledCount += workerFilledCount;
+    });
+
+    return filledCount;
+}
+
+// Same with singles, locked candidates and backtracking, which solves every valid puzzle
+template<typename Grid, typename Descriptor = SudokuDescriptor<Grid>>
+std::size_t solveBatch(std::span<Grid const> puzzles, std::span<Grid> out, BatchOptions const& options = {})
+{
+    return solveBatch<Grid, Descriptor>(puzzles
+                                      , out
+                                      , options
+                                      , []
+                                        {
+                                            auto pipeline = std::make_unique<SolverPipeline<Grid, Descriptor>>();
+                                            pipeline->template add<NakedSingleSolver<Grid, Descriptor>>();
+                                            pipeline->template add<HiddenSingleSolver<Grid, Descriptor>>();
+                                            pipeline->template add<LockedCandidatesSolver<Grid, Descriptor>>();
+                                            pipeline->template add<BacktrackingSolver<Grid, Descriptor>>();
+                                            return pipeline;
+                                        });
+}
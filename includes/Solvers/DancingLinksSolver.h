@@ -0,0 +1,118 @@
+// Copyright 2022 DrSinIsIn (axel.gaillard.dev@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "AbstractSolver.h"
+#include "Utility/DancingLinks.h"
+#include "Utility/GridTopology.h"
+
+// Last resort strategy solving the grid as an exact cover problem: one column per cell and one per (house, value)
+// pair, one row per candidate left in the descriptor. Seeding the matrix with the candidates left by cheaper
+// strategies keeps it, and the search, proportional to what is still unknown rather than to the grid's area.
+// solveOnce only modifies the descriptor when a solution has been found, in which case the descriptor is left
+// filled with it.
+template<typename Grid, typename Descriptor = SudokuDescriptor<Grid>>
+class DancingLinksSolver : public AbstractSolver<Grid, Descriptor>
+{
+public:
+    using GridDescriptor = typename AbstractSolver<Grid, Descriptor>::GridDescriptor;
+    using Bitset = typename AbstractSolver<Grid, Descriptor>::Bitset;
+    using Integer = typename AbstractSolver<Grid, Descriptor>::Integer;
+    using Topology = GridTopology<Grid>;
+
+    bool solveOnce(GridDescriptor& gridDescriptor) override
+    {
+        if (gridDescriptor.isFilled())
+        {
+            return false;
+        }
+
+        CandidateMatrix matrix{ gridDescriptor };
+        bool found = false;
+        matrix.links.search(1, [&](std::span<std::size_t const> rows)
+        {
+            for (auto row : rows)
+            {
+                auto const [cell, value] = matrix.candidates[row];
+                if (gridDescriptor.missingValuesMask().test(GridDescriptor::bitIndex(cell, value)))
+                {
+                    gridDescriptor.setValue(cell, value);
+                }
+            }
+
+            found = true;
+            return false;
+        });
+
+        return found;
+    }
+
+    // Number of solutions of the grid the descriptor is in, counting up to limit
+    static std::size_t countSolutions(GridDescriptor const& gridDescriptor, std::size_t limit)
+    {
+        return CandidateMatrix{ gridDescriptor }.links.countSolutions(limit);
+    }
+
+private:
+    static constexpr std::size_t columnCount = Grid::cellCount + (Topology::houseCount * Grid::maxValue);
+
+    struct CandidateMatrix
+    {
+        DancingLinks links;
+        std::vector<std::pair<std::size_t, Integer>> candidates; // (cell, value) of each row
+
+        explicit CandidateMatrix(GridDescriptor const& descriptor)
+            : links{ columnCount, 4 * descriptor.possibilities().count() }
+        {
+            candidates.reserve(descriptor.possibilities().count());
+
+            // Rows of placed values are selected from the start
+            std::vector<std::size_t> placedRows;
+            for (std::size_t cell = 0; cell < Grid::cellCount; ++cell)
+            {
+                bool const isPlaced = !descriptor.missingValuesMask().test(GridDescriptor::bitIndex(cell, 1));
+                for (Integer value = 1; value <= Grid::maxValue; ++value)
+                {
+                    if (!descriptor.possibilities().test(GridDescriptor::bitIndex(cell, value)))
+                    {
+                        continue;
+                    }
+
+                    auto const& [row, column, box] = Topology::cellHouses[cell];
+                    std::array<std::size_t, 4> const columns{ cell
+                                                            , houseColumn(row, value)
+                                                            , houseColumn(column, value)
+                                                            , houseColumn(box, value) };
+                    std::size_t const matrixRow = links.addRow(columns);
+                    candidates.emplace_back(cell, value);
+                    if (isPlaced)
+                    {
+                        placedRows.push_back(matrixRow);
+                    }
+                }
+            }
+
+            for (auto placedRow : placedRows)
+            {
+                if (!links.select(placedRow))
+                {
+                    break;
+                }
+            }
+        }
+
+        static constexpr std::size_t houseColumn(std::size_t house, Integer value) noexcept
+        {
+            return Grid::cellCount + (house * Grid::maxValue) + (value - 1);
+        }
+    };
+};
@@ -0,0 +1,150 @@
+// Copyright 2022 DrSinIsIn (axel.gaillard.dev@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string_view>
+
+#include "BasicFishSolver.h"
+#include "BatchSolving.h"
+#include "DancingLinksSolver.h"
+#include "FinnedFishSolver.h"
+#include "HiddenTupleSolver.h"
+#include "LockedCandidatesSolver.h"
+#include "NakedSingleSolver.h"
+#include "NakedTupleSolver.h"
+#include "SolverPipeline.h"
+
+// Techniques a puzzle may need, from the cheapest to the most expensive one
+enum class Technique
+{
+    NakedSingle,
+    HiddenSingle,
+    LockedCandidates,
+    NakedPair,
+    HiddenPair,
+    NakedTriple,
+    HiddenTriple,
+    XWing,
+    Swordfish,
+    FinnedXWing,
+    FinnedSwordfish,
+};
+
+inline constexpr std::size_t techniqueCount = static_cast<std::size_t>(Technique::FinnedSwordfish) + 1;
+
+// Same names as the strategies of sudoku-solve
+constexpr std::string_view techniqueName(Technique technique) noexcept
+{
+    constexpr std::array<std::string_view, techniqueCount> names{ "naked-single"
+                                                                , "hidden-single"
+                                                                , "locked-candidates"
+                                                                , "naked-pair"
+                                                                , "hidden-pair"
+                                                                , "naked-triple"
+                                                                , "hidden-triple"
+                                                                , "x-wing"
+                                                                , "swordfish"
+                                                                , "finned-x-wing"
+                                                                , "finned-swordfish" };
+    return names[static_cast<std::size_t>(technique)];
+}
+
+struct Grade
+{
+    // Number of times each technique made progress, indexed by Technique
+    std::array<std::size_t, techniqueCount> applicationCounts{};
+    std::optional<Technique> hardest; // Most expensive technique that made progress, if any did
+    bool guessed = false;             // Techniques got stuck before the grid was filled
+    bool solved = false;              // The puzzle has a solution, found with or without guessing
+
+    std::size_t applicationCount(Technique technique) const
+    {
+        return applicationCounts[static_cast<std::size_t>(technique)];
+    }
+};
+
+// Grades puzzles by the techniques needed to solve them: techniques run in cost order, any progress restarting from
+// the cheapest one, so that a technique is only counted when every cheaper one is stuck. When they all are before the
+// grid is filled, the rest is guessed with the exact cover search. A grader keeps its strategies between puzzles;
+// use one per thread, or gradeBatch.
+template<typename Grid, typename Descriptor = SudokuDescriptor<Grid>>
+class DifficultyGrader
+{
+public:
+    using GridDescriptor = Descriptor;
+
+    DifficultyGrader()
+    {
+        m_pipeline.template add<NakedSingleSolver<Grid, Descriptor>>();
+        m_pipeline.template add<HiddenSingleSolver<Grid, Descriptor>>();
+        m_pipeline.template add<LockedCandidatesSolver<Grid, Descriptor>>();
+        m_pipeline.template add<NakedPairSolver<Grid, Descriptor>>();
+        m_pipeline.template add<HiddenTupleSolver<2, Grid, Descriptor>>();
+        m_pipeline.template add<NakedTripleSolver<Grid, Descriptor>>();
+        m_pipeline.template add<HiddenTupleSolver<3, Grid, Descriptor>>();
+        m_pipeline.template add<XWingSolver<Grid, Descriptor>>();
+        m_pipeline.template add<SwordfishSolver<Grid, Descriptor>>();
+        m_pipeline.template add<FinnedXWingSolver<Grid, Descriptor>>();
+        m_pipeline.template add<FinnedSwordfishSolver<Grid, Descriptor>>();
+        assert(m_pipeline.size() == techniqueCount);
+    }
+
+    Grade grade(Grid const& puzzle)
+    {
+        GridDescriptor descriptor{ puzzle };
+        return grade(descriptor);
+    }
+
+    // Leaves the descriptor solved when the puzzle has a solution
+    Grade grade(GridDescriptor& descriptor)
+    {
+        Grade result;
+
+        auto const report = m_pipeline.solve(descriptor);
+        for (std::size_t i = 0; i < techniqueCount; ++i)
+        {
+            result.applicationCounts[i] = report.applicationCounts[i];
+            if (report.applicationCounts[i] > 0)
+            {
+                result.hardest = static_cast<Technique>(i);
+            }
+        }
+
+        if (!descriptor.isFilled())
+        {
+            result.guessed = true;
+            m_search.solveOnce(descriptor);
+        }
+
+        result.solved = descriptor.isFilled() && !descriptor.isContradiction();
+        return result;
+    }
+
+private:
+    SolverPipeline<Grid, Descriptor> m_pipeline;
+    DancingLinksSolver<Grid, Descriptor> m_search;
+};
+
+// Grades every puzzle, spread over the threads of options: out[i] is the grade of puzzles[i]
+template<typename Grid, typename Descriptor = SudokuDescriptor<Grid>>
+void gradeBatch(std::span<Grid const> puzzles, std::span<Grade> out, BatchOptions const& options = {})
+{
+    assert(out.size() >= puzzles.size());
+
+    details::runWorkers(puzzles.size(), options, [&](std::size_t worker, details::WorkStealingRanges& ranges)
+    {
+        DifficultyGrader<Grid, Descriptor> grader;
+        while (auto const index = ranges.next(worker))
+        {
+            out[*index] = grader.grade(puzzles[*index]);
+        }
+    });
+}
@@ -0,0 +1,335 @@
+// Copyright 2022 DrSinIsIn (axel.gaillard.dev@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+#include "AbstractSolver.h"
+#include "Utility/GridTopology.h"
+#include "Utility/SetBitIterator.h"
+
+// Houses a fish takes its base and cover sets from
+enum class FishShape
+{
+    Basic,   // Rows covered by columns, or columns covered by rows
+    Franken, // Rows and boxes covered by columns and boxes, or columns and boxes covered by rows and boxes
+};
+
+// Fish of a given size, with or without fins, searched one value at a time over cell sets.
+// size base houses sharing no candidate for the value, whose candidates all lie in size cover houses but for some
+// fins, remove the value from the cover houses' other cells that see every fin (all of them when there is no fin).
+// Sashimi fish are the finned fish where a base house only has fins left outside of the cover houses.
+template<std::size_t size
+       , typename Grid
+       , typename Descriptor = SudokuDescriptor<Grid>
+       , FishShape shape = FishShape::Basic>
+    requires (size > 1) && (size < Grid::columnCount)
+class FinnedFishSolver : public AbstractSolver<Grid, Descriptor>
+{
+public:
+    using GridDescriptor = typename AbstractSolver<Grid, Descriptor>::GridDescriptor;
+    using Bitset = typename AbstractSolver<Grid, Descriptor>::Bitset;
+    using Integer = typename AbstractSolver<Grid, Descriptor>::Integer;
+    using Changes = typename AbstractSolver<Grid, Descriptor>::Changes;
+    using CellSet = typename GridDescriptor::CellSet;
+    using Topology = GridTopology<Grid>;
+
+    bool solveOnce(GridDescriptor& gridDescriptor) override
+    {
+        bool found = false;
+
+        for (Integer value = 1; value <= Grid::maxValue; ++value)
+        {
+            found |= solveFishFor(gridDescriptor, value);
+        }
+
+        return found;
+    }
+
+    // Fish only depend on the candidates of their value
+    bool solveChanged(GridDescriptor& gridDescriptor, Changes const& changes) override
+    {
+        bool found = false;
+
+        for (auto const bit : setBits(changes.values))
+        {
+            found |= solveFishFor(gridDescriptor, static_cast<Integer>(bit + 1));
+        }
+
+        return found;
+    }
+
+    bool usesChanges() const override
+    {
+        return true;
+    }
+
+private:
+    static constexpr bool withBoxes = (shape == FishShape::Franken);
+
+    // Base houses are the lines starting at baseLines (and the boxes for Franken fish), likewise for cover houses
+    struct Orientation
+    {
+        std::size_t baseLines{};
+        std::size_t coverLines{};
+    };
+
+    static constexpr std::array<Orientation, 2> orientations{ Orientation{ Topology::rowHouse(0)
+                                                                         , Topology::columnHouse(0) }
+                                                            , Orientation{ Topology::columnHouse(0)
+                                                                         , Topology::rowHouse(0) } };
+
+    static constexpr std::size_t maxBaseHouseCount = (withBoxes ? 2 : 1) * Grid::maxValue;
+
+    // Basic fins all lie in one box, which crosses a line over at most a box side
+    static constexpr std::size_t maxBaseCandidateCount = withBoxes
+                                                       ? Grid::maxValue
+                                                       : size + std::max(Grid::boxWidth, Grid::boxHeight);
+
+    struct FishCandidates
+    {
+        Integer value{};
+        Orientation orientation{};
+        CellSet cells{}; // Unsolved cells where the value is possible
+        std::array<std::size_t, maxBaseHouseCount> baseHouses{};
+        std::array<CellSet, maxBaseHouseCount> baseCells{};
+        std::size_t baseHouseCount{};
+    };
+
+    std::array<std::size_t, size> m_baseHousesBuffer{};
+
+    bool solveFishFor(GridDescriptor& descriptor, Integer value)
+    {
+        bool hasSolved = false;
+
+        for (auto const& orientation : orientations)
+        {
+            hasSolved |= solveFishFor(descriptor, value, orientation);
+        }
+
+        return hasSolved;
+    }
+
+    bool solveFishFor(GridDescriptor& descriptor, Integer value, Orientation const& orientation)
+    {
+        FishCandidates candidates = gatherCandidates(descriptor, value, orientation);
+        if (candidates.baseHouseCount < size)
+        {
+            return false;
+        }
+
+        return findBase(descriptor, candidates, 0, CellSet{});
+    }
+
+    static FishCandidates gatherCandidates(GridDescriptor const& descriptor
+                                         , Integer value
+                                         , Orientation const& orientation)
+    {
+        FishCandidates candidates{ value, orientation, descriptor.valueCells(value) };
+
+        CellSet placed{};
+        for (auto const cell : setBits(candidates.cells))
+        {
+            if (!descriptor.missingValuesMask().test(GridDescriptor::bitIndex(cell, value)))
+            {
+                placed.set(cell);
+            }
+        }
+        candidates.cells &= ~placed;
+
+        auto const addBaseHouse = [&](std::size_t house)
+        {
+            CellSet const& houseCells = GridDescriptor::houseCells(house);
+            CellSet const cells = houseCells & candidates.cells;
+            std::size_t const count = cells.count();
+            if ((houseCells & placed).none() && (count > 1) && (count <= maxBaseCandidateCount))
+            {
+                candidates.baseHouses[candidates.baseHouseCount] = house;
+                candidates.baseCells[candidates.baseHouseCount] = cells;
+                ++candidates.baseHouseCount;
+            }
+        };
+
+        for (std::size_t line = 0; line < Grid::maxValue; ++line)
+        {
+            addBaseHouse(orientation.baseLines + line);
+        }
+
+        if constexpr (withBoxes)
+        {
+            for (std::size_t box = 0; box < Grid::boxCount; ++box)
+            {
+                addBaseHouse(Topology::boxHouse(box));
+            }
+        }
+
+        return candidates;
+    }
+
+    template<std::size_t depth = 0>
+    bool findBase(GridDescriptor& descriptor
+                , FishCandidates& candidates
+                , std::size_t firstIndex
+                , CellSet const& baseCells
+                , std::integral_constant<std::size_t, depth> = {})
+    {
+        if constexpr (depth == size)
+        {
+            return findCovers(descriptor, candidates, baseCells);
+        }
+        else
+        {
+            bool hasSolved = false;
+
+            std::size_t const lastIndex = candidates.baseHouseCount - (size - depth);
+            for (std::size_t index = firstIndex; index <= lastIndex; ++index)
+            {
+                // Each base house needs its own instance of the value
+                if ((candidates.baseCells[index] & baseCells).none())
+                {
+                    m_baseHousesBuffer[depth] = candidates.baseHouses[index];
+                    hasSolved |= findBase(descriptor
+                                        , candidates
+                                        , index + 1
+                                        , baseCells | candidates.baseCells[index]
+                                        , std::integral_constant<std::size_t, depth + 1> {});
+                }
+            }
+
+            return hasSolved;
+        }
+    }
+
+    // Without fins, then with the fins in each box the base houses reach
+    bool findCovers(GridDescriptor& descriptor, FishCandidates& candidates, CellSet const& baseCells)
+    {
+        bool hasSolved = findCover(descriptor, candidates, baseCells, baseCells, CellSet{}, false);
+
+        for (std::size_t box = 0; box < Grid::boxCount; ++box)
+        {
+            CellSet const& boxCells = GridDescriptor::houseCells(Topology::boxHouse(box));
+            if ((baseCells & boxCells).any())
+            {
+                hasSolved |= findCover(descriptor, candidates, baseCells, baseCells & ~boxCells, CellSet{}, true);
+            }
+        }
+
+        return hasSolved;
+    }
+
+    // Branches on the cover houses of the first target cell left uncovered, of which there are at most two
+    template<std::size_t depth = 0>
+    bool findCover(GridDescriptor& descriptor
+                 , FishCandidates& candidates
+                 , CellSet const& baseCells
+                 , CellSet const& targetCells
+                 , CellSet const& coverCells
+                 , bool isFinned
+                 , std::integral_constant<std::size_t, depth> = {}) const
+    {
+        CellSet const uncovered = targetCells & ~coverCells;
+        if (uncovered.none())
+        {
+            // Fewer cover houses than base houses are left to smaller fish
+            return (depth == size) && eliminate(descriptor, candidates, baseCells, coverCells, isFinned);
+        }
+
+        if constexpr (depth == size)
+        {
+            return false;
+        }
+        else
+        {
+            bool hasSolved = false;
+
+            auto const cell = *setBits(uncovered).begin();
+            for (auto house : Topology::cellHouses[cell])
+            {
+                if (isCoverHouse(house, candidates.orientation))
+                {
+                    hasSolved |= findCover(descriptor
+                                         , candidates
+                                         , baseCells
+                                         , targetCells
+                                         , coverCells | (GridDescriptor::houseCells(house) & candidates.cells)
+                                         , isFinned
+                                         , std::integral_constant<std::size_t, depth + 1> {});
+                }
+            }
+
+            return hasSolved;
+        }
+    }
+
+    bool isCoverHouse(std::size_t house, Orientation const& orientation) const
+    {
+        if ((house >= orientation.coverLines) && (house < (orientation.coverLines + Grid::maxValue)))
+        {
+            return true;
+        }
+
+        // Boxes may be base or cover houses, but not both at once
+        return withBoxes
+            && (house >= Topology::boxHouse(0))
+            && (std::ranges::find(m_baseHousesBuffer, house) == m_baseHousesBuffer.end());
+    }
+
+    static bool eliminate(GridDescriptor& descriptor
+                        , FishCandidates& candidates
+                        , CellSet const& baseCells
+                        , CellSet const& coverCells
+                        , bool isFinned)
+    {
+        // Fish without fins are left to the search without fins
+        CellSet const fins = baseCells & ~coverCells;
+        if (isFinned == fins.none())
+        {
+            return false;
+        }
+
+        // If no fin holds the value, the base houses hold it at the cover houses' crossings; if a fin does, it
+        // removes the value from its peers. Either way, cells seeing every fin can't hold it.
+        CellSet eliminated = coverCells & ~baseCells;
+        for (auto const fin : setBits(fins))
+        {
+            if (eliminated.none())
+            {
+                break;
+            }
+
+            auto const& [row, column, box] = Topology::cellHouses[fin];
+            eliminated &= GridDescriptor::houseCells(row)
+                        | GridDescriptor::houseCells(column)
+                        | GridDescriptor::houseCells(box);
+        }
+
+        bool hasSolved = false;
+        for (auto const cell : setBits(eliminated))
+        {
+            auto const bit = GridDescriptor::bitIndex(cell, candidates.value);
+            if (descriptor.possibilities().test(bit))
+            {
+                descriptor.possibilities().reset(bit);
+                hasSolved = true;
+            }
+        }
+
+        candidates.cells &= ~eliminated;
+        return hasSolved;
+    }
+};
+
+template<std::size_t size, typename Grid, typename Descriptor = SudokuDescriptor<Grid>>
+using FrankenFishSolver = FinnedFishSolver<size, Grid, Descriptor, FishShape::Franken>;
+
+template<typename Grid, typename Descriptor = SudokuDescriptor<Grid>>
+using FinnedXWingSolver = FinnedFishSolver<2, Grid, Descriptor>;
+
+template<typename Grid, typename Descriptor = SudokuDescriptor<Grid>>
+using FinnedSwordfishSolver = FinnedFishSolver<3, Grid, Descriptor>;
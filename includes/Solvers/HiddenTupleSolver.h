@@ -5,169 +5,227 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <bit>
 #include <cstddef>
-#include <type_traits>
+#include <span>
 
 #include "AbstractSolver.h"
+#include "Utility/CompactSudokuDescriptor.h"
+#include "Utility/GridTopology.h"
+#include "Utility/MathUtils.h"
+#include "Utility/SetBitIterator.h"
 
 
-template<std::size_t tupleSize, typename Grid>
+template<std::size_t tupleSize, typename Grid, typename Descriptor = SudokuDescriptor<Grid>>
     requires (tupleSize > 0)
           && (tupleSize < Grid::columnCount)
-class HiddenTupleSolver : public AbstractSolver<Grid>
+class HiddenTupleSolver : public AbstractSolver<Grid, Descriptor>
 {
 public:
-    using GridDescriptor = typename AbstractSolver<Grid>::GridDescriptor;
-    using Bitset = typename AbstractSolver<Grid>::Bitset;
-    using Integer = typename AbstractSolver<Grid>::Integer;
+    using GridDescriptor = typename AbstractSolver<Grid, Descriptor>::GridDescriptor;
+    using Bitset = typename AbstractSolver<Grid, Descriptor>::Bitset;
+    using Integer = typename AbstractSolver<Grid, Descriptor>::Integer;
+    using Changes = typename AbstractSolver<Grid, Descriptor>::Changes;
+    using Topology = GridTopology<Grid>;
 
     bool solveOnce(GridDescriptor& gridDescriptor) override
     {
         bool found = false;
 
-        for (std::size_t i = 0; i < Grid::columnCount; ++i)
+        for (std::size_t house = 0; house < Topology::houseCount; ++house)
         {
-            found |= solveHiddenTuplesFor(gridDescriptor, Column{ gridDescriptor.columnMask(i), i, Grid::maxValue });
-            found |= solveHiddenTuplesFor(gridDescriptor, Row{ gridDescriptor.rowMask(i), i, Grid::maxValue });
-            found |= solveHiddenTuplesFor(gridDescriptor, Box{ gridDescriptor.boxMask(i), i, Grid::maxValue });
+            found |= solveHiddenTuplesFor(gridDescriptor, house);
         }
 
         return found;
     }
 
-private:
-    struct House
+    // Tuples only depend on the candidates of their house
+    bool solveChanged(GridDescriptor& gridDescriptor, Changes const& changes) override
     {
-        House(Bitset const& mask, std::size_t index, std::size_t size)
-            : mask{ mask }
-            , houseIndex{ index }
-            , houseSize{ size }
-        {}
+        bool found = false;
 
-        Bitset mask;
-        std::size_t houseIndex{};
-        std::size_t houseSize{};
+        for (auto const house : setBits(changes.houses))
+        {
+            found |= solveHiddenTuplesFor(gridDescriptor, house);
+        }
 
-        virtual std::size_t getCellAbsoluteIndex(std::size_t localIndex) const = 0;
-    };
+        return found;
+    }
 
-    struct Row : House
+    bool usesChanges() const override
     {
-        using House::House;
+        return true;
+    }
 
-        std::size_t getCellAbsoluteIndex(std::size_t localIndex) const override
-        {
-            return Grid::coordinatesToCell(localIndex, House::houseIndex);
-        }
+private:
+    // One bit per cell of a house, also used for one bit per value
+    using Positions = typename Topology::HousePositions;
+
+    static constexpr Positions bit(std::size_t index) noexcept
+    {
+        return static_cast<Positions>(Positions{ 1 } << index);
+    }
+
+    using Combinations = MathUtils::BoundedUnionCombinations<tupleSize, Positions>;
+
+    // Candidates of a house, restricted to its unsolved cells and values
+    struct HouseCandidates
+    {
+        std::size_t house{};
+        std::array<Integer, Grid::maxValue> openValues{};
+        std::array<Positions, Grid::maxValue> openValuePositions{}; // Positions of each open value
+        std::size_t openValueCount{};
     };
 
-    struct Column : House
+    bool solveHiddenTuplesFor(GridDescriptor& descriptor, std::size_t house) const
     {
-        using House::House;
+        HouseCandidates candidates = gatherCandidates(descriptor, house);
 
-        std::size_t getCellAbsoluteIndex(std::size_t localIndex) const override
+        // k values among k or fewer open ones can only be confined to the cells they already fill
+        if (candidates.openValueCount <= tupleSize)
         {
-            return Grid::coordinatesToCell(House::houseIndex, localIndex);
+            return false;
         }
-    };
 
-    struct Box : House
-    {
-        using House::House;
+        bool hasSolved = false;
 
-        std::size_t getCellAbsoluteIndex(std::size_t localIndex) const override
+        // Values spread over more than tupleSize cells can't be part of a tuple
+        std::span<Positions const> const positions{ candidates.openValuePositions.data(), candidates.openValueCount };
+        for (auto const& tuple : Combinations{ positions, tupleSize })
         {
-            auto const [boxX, boxY] = Grid::cellToCoordinates(Grid::boxIndexToTopLeftCell(House::houseIndex));
-            return Grid::coordinatesToCell(boxX + (localIndex % Grid::boxWidth), boxY + (localIndex / Grid::boxWidth));
+            if (static_cast<std::size_t>(std::popcount(tuple.unionMask)) == tupleSize)
+            {
+                hasSolved |= restrictToTuple(descriptor, candidates, tuple);
+            }
         }
-    };
 
-    std::array<Integer, tupleSize> m_tupleValuesBuffer{};
+        return hasSolved;
+    }
 
-    template<std::size_t recursionIndex = 0>
-    bool solveHiddenTuplesFor(GridDescriptor& descriptor
-                            , House const& house
-                            , Bitset const& cellsMask = {}
-                            , std::size_t startIndex = 0
-                            , std::integral_constant<std::size_t, recursionIndex> = {})
+    static HouseCandidates gatherCandidates(GridDescriptor const& descriptor, std::size_t house)
     {
-        bool hasSolved = false;
-        if constexpr (recursionIndex == tupleSize)
+        HouseCandidates candidates{ house };
+        std::array<Positions, Grid::maxValue> valuePositions{}; // Indexed by value - 1
+        Positions placedValues{};
+
+        auto const& possibilities = descriptor.possibilities();
+        for (std::size_t position = 0; auto cell : Topology::houseCells[house])
         {
-            return solveHiddenTuplesFor(descriptor, house.mask, cellsMask);
+            // Placing a value clears all the missing bits of its cell
+            bool const isPlaced = !descriptor.missingValuesMask().test(GridDescriptor::bitIndex(cell, 1));
+            for (Integer value = 1; value <= Grid::maxValue; ++value)
+            {
+                if (possibilities.test(GridDescriptor::bitIndex(cell, value)))
+                {
+                    if (isPlaced)
+                    {
+                        placedValues |= bit(value - 1);
+                    }
+                    else
+                    {
+                        valuePositions[value - 1] |= bit(position);
+                    }
+                }
+            }
+            ++position;
         }
-        else
+
+        // Values with no position left only show a contradiction, which is not for this solver to report
+        for (Integer value = 1; value <= Grid::maxValue; ++value)
         {
-            std::size_t const maxCellIndex = house.houseSize - (tupleSize - recursionIndex);
-            for (; startIndex <= maxCellIndex;)
+            if (((placedValues & bit(value - 1)) == 0) && (valuePositions[value - 1] != 0))
             {
-                Bitset const newCellsMask = cellsMask | descriptor.cellMask(house.getCellAbsoluteIndex(startIndex));
-                hasSolved |= solveHiddenTuplesFor(descriptor
-                                                , house
-                                                , newCellsMask
-                                                , ++startIndex
-                                                , std::integral_constant<std::size_t, recursionIndex + 1> {});
+                candidates.openValues[candidates.openValueCount] = value;
+                candidates.openValuePositions[candidates.openValueCount] = valuePositions[value - 1];
+                ++candidates.openValueCount;
             }
         }
 
-        return hasSolved;
+        return candidates;
     }
 
-    template<std::size_t recursionIndex = 0>
-    bool solveHiddenTuplesFor(GridDescriptor& descriptor
-                            , Bitset const& houseMask
-                            , Bitset const& cellsMask
-                            , Integer startValue = 0
-                            , std::integral_constant<std::size_t, recursionIndex> = {})
+    // The tuple's values fill the tuple's cells, any other value is removed from them
+    static bool restrictToTuple(GridDescriptor& descriptor
+                              , HouseCandidates& candidates
+                              , typename Combinations::Combination const& tuple)
     {
         bool hasSolved = false;
-        if constexpr (recursionIndex == tupleSize)
-        {
-            auto const oldPossibilities = descriptor.possibilities();
-            auto const hiddenTupleMask = findHiddenTupleFor(descriptor
-                                                          , houseMask
-                                                          , cellsMask
-                                                          , std::make_index_sequence<tupleSize> {});
-
-            descriptor.possibilities() &= hiddenTupleMask;
-            hasSolved = oldPossibilities != descriptor.possibilities();
-        }
-        else
+
+        auto const& cells = Topology::houseCells[candidates.house];
+        for (std::size_t i = 0; i < candidates.openValueCount; ++i)
         {
-            std::size_t const maxValue = Grid::maxValue - (tupleSize - recursionIndex);
-            for (; startValue < maxValue;)
+            Positions& positions = candidates.openValuePositions[i];
+            Positions removed = positions & tuple.unionMask;
+            if ((removed == 0) || (std::ranges::find(tuple.indices, i) != tuple.indices.end()))
             {
-                m_tupleValuesBuffer[recursionIndex] = ++startValue;
-                hasSolved |= solveHiddenTuplesFor(descriptor
-                                                , houseMask
-                                                , cellsMask
-                                                , startValue
-                                                , std::integral_constant<std::size_t, recursionIndex + 1> {});
+                continue;
             }
+
+            for (; removed != 0; removed &= static_cast<Positions>(removed - 1))
+            {
+                auto const cell = cells[std::countr_zero(removed)];
+                descriptor.possibilities().reset(GridDescriptor::bitIndex(cell, candidates.openValues[i]));
+            }
+
+            positions &= static_cast<Positions>(~tuple.unionMask);
+            hasSolved = true;
         }
 
         return hasSolved;
     }
+};
+
+template<typename Grid>
+class HiddenTupleSolver<1, Grid, CompactSudokuDescriptor<Grid>>
+    : public AbstractSolver<Grid, CompactSudokuDescriptor<Grid>>
+{
+public:
+    using GridDescriptor = CompactSudokuDescriptor<Grid>;
+    using Candidates = typename GridDescriptor::Candidates;
+    using Topology = typename GridDescriptor::Topology;
 
-    template<std::size_t... indices>
-    Bitset findHiddenTupleFor(GridDescriptor const& descriptor
-                            , Bitset const& houseMask
-                            , Bitset const& cellsMask
-                            , std::index_sequence<indices...>) const
+    bool solveOnce(GridDescriptor& gridDescriptor) override
     {
-        auto const valuesPossibilities = (descriptor.possibilitiesForValue(m_tupleValuesBuffer[indices]) | ...);
-        auto const valuesHouseMask = valuesPossibilities & houseMask;
-        auto const hiddenTupleMask = valuesPossibilities & cellsMask;
+        bool found = false;
 
-        if (hiddenTupleMask == valuesHouseMask)
+        for (std::size_t house = 0; house < Topology::houseCount; ++house)
         {
-            return ~cellsMask | hiddenTupleMask;
+            auto const& cells = Topology::houseCells[house];
+
+            // Values seen at least once, and at least twice, among the house's cells
+            Candidates once{};
+            Candidates twice{};
+            for (auto cell : cells)
+            {
+                Candidates const candidates = gridDescriptor.candidates(cell);
+                twice |= once & candidates;
+                once |= candidates;
+            }
+
+            Candidates hiddenSingles = once & static_cast<Candidates>(~twice)
+                                     & static_cast<Candidates>(~gridDescriptor.placedValues(house));
+            for (; hiddenSingles != 0; hiddenSingles &= static_cast<Candidates>(hiddenSingles - 1))
+            {
+                Candidates const valueBit = hiddenSingles & static_cast<Candidates>(-hiddenSingles);
+                for (auto cell : cells)
+                {
+                    // Placements made earlier in this pass may have removed the candidate
+                    if ((gridDescriptor.value(cell) == 0) && ((gridDescriptor.candidates(cell) & valueBit) != 0))
+                    {
+                        gridDescriptor.setValue(cell, GridDescriptor::bitToValue(valueBit));
+                        found = true;
+                        break;
+                    }
+                }
+            }
         }
 
-        return Bitset{}.set();
+        return found;
     }
 };
 
-template<typename Grid>
-using HiddenSingleSolver = HiddenTupleSolver<1, Grid>;
+template<typename Grid, typename Descriptor = SudokuDescriptor<Grid>>
+using HiddenSingleSolver = HiddenTupleSolver<1, Grid, Descriptor>;
@@ -8,41 +8,52 @@
 #include <cstddef>
 
 #include "AbstractSolver.h"
+#include "Utility/GridTopology.h"
+#include "Utility/SetBitIterator.h"
 
 
-template<typename Grid>
-class LockedCandidatesSolver : public AbstractSolver<Grid>
+template<typename Grid, typename Descriptor = SudokuDescriptor<Grid>>
+class LockedCandidatesSolver : public AbstractSolver<Grid, Descriptor>
 {
 public:
-    using GridDescriptor = typename AbstractSolver<Grid>::GridDescriptor;
-    using Bitset = typename AbstractSolver<Grid>::Bitset;
-    using Integer = typename AbstractSolver<Grid>::Integer;
+    using GridDescriptor = typename AbstractSolver<Grid, Descriptor>::GridDescriptor;
+    using Bitset = typename AbstractSolver<Grid, Descriptor>::Bitset;
+    using Integer = typename AbstractSolver<Grid, Descriptor>::Integer;
+    using CellSet = typename GridDescriptor::CellSet;
+    using Topology = GridTopology<Grid>;
 
+    // Works on the cells where each value is possible, which with value planes are read straight from the value's
+    // words rather than masked out of whole-grid bitsets
     bool solveOnce(GridDescriptor& gridDescriptor) override
     {
         bool found = false;
         for (Integer value = 1; value <= Grid::maxValue; ++value)
         {
-            Bitset const valueMask = gridDescriptor.valueMask(value);
+            CellSet valueCells = gridDescriptor.valueCells(value);
             for (std::size_t i = 0; i < Grid::boxCount; ++i)
             {
-                // reducing possibleCells
-                Bitset const boxXValueMask = gridDescriptor.boxMask(i) & valueMask;
+                CellSet const& boxCells = GridDescriptor::houseCells(Topology::boxHouse(i));
 
                 auto const [boxTopLeftCellX, boxTopLeftCellY] =
                     Grid::cellToCoordinates(Grid::boxIndexToTopLeftCell(i));
                 for (std::size_t j = 0; j < Grid::boxWidth; ++j)
                 {
-                    found |= solveLockedCandidatesFor(gridDescriptor.possibilities()
-                                                    , boxXValueMask
-                                                    , gridDescriptor.columnMask(boxTopLeftCellX + j) & valueMask);
+                    auto const column = Topology::columnHouse(boxTopLeftCellX + j);
+                    found |= solveLockedCandidatesFor(gridDescriptor
+                                                    , value
+                                                    , valueCells
+                                                    , boxCells
+                                                    , GridDescriptor::houseCells(column));
                 }
 
                 for (std::size_t j = 0; j < Grid::boxHeight; ++j)
                 {
-                    found |= solveLockedCandidatesFor(gridDescriptor.possibilities()
-                                                    , boxXValueMask
-                                                    , gridDescriptor.rowMask(boxTopLeftCellY + j) & valueMask);
+                    auto const row = Topology::rowHouse(boxTopLeftCellY + j);
+                    found |= solveLockedCandidatesFor(gridDescriptor
+                                                    , value
+                                                    , valueCells
+                                                    , boxCells
+                                                    , GridDescriptor::houseCells(row));
                 }
             }
         }
@@ -51,27 +62,36 @@ public:
     }
 
 private:
-    bool solveLockedCandidatesFor(Bitset& possibleCells
-                                , Bitset const& maskA
-                                , Bitset const& maskB) const
+    // valueCells is kept up to date with the candidates removed
+    bool solveLockedCandidatesFor(GridDescriptor& gridDescriptor
+                                , Integer value
+                                , CellSet& valueCells
+                                , CellSet const& houseA
+                                , CellSet const& houseB) const
     {
-        Bitset const possibleCellsXMaskA = possibleCells & maskA;
-        Bitset const possibleCellsXMaskB = possibleCells & maskB;
+        CellSet const possibleCellsXHouseA = valueCells & houseA;
+        CellSet const possibleCellsXHouseB = valueCells & houseB;
 
-        if (possibleCellsXMaskA == possibleCellsXMaskB)
+        if (possibleCellsXHouseA == possibleCellsXHouseB)
         {
             return false;
         }
 
-        Bitset const crossPossibilities = possibleCellsXMaskA & possibleCellsXMaskB;
+        CellSet const crossPossibilities = possibleCellsXHouseA & possibleCellsXHouseB;
         if (crossPossibilities.none())
         {
             return false;
         }
 
-        if ((possibleCellsXMaskA == crossPossibilities) || (possibleCellsXMaskB == crossPossibilities))
+        if ((possibleCellsXHouseA == crossPossibilities) || (possibleCellsXHouseB == crossPossibilities))
         {
-            possibleCells &= ~(maskA ^ maskB);
+            CellSet const removed = possibleCellsXHouseA ^ possibleCellsXHouseB;
+            for (auto const cell : setBits(removed))
+            {
+                gridDescriptor.possibilities().reset(GridDescriptor::bitIndex(cell, value));
+            }
+
+            valueCells &= ~removed;
             return true;
         }
 
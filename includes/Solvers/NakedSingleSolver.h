@@ -5,30 +5,37 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <utility>
 
 #include "AbstractSolver.h"
+#include "Utility/CompactSudokuDescriptor.h"
 #include "Utility/SetBitIterator.h"
 
 
-template<typename Grid>
-class NakedSingleSolver : public AbstractSolver<Grid>
+template<typename Grid, typename Descriptor = SudokuDescriptor<Grid>>
+class NakedSingleSolver : public AbstractSolver<Grid, Descriptor>
 {
 public:
-    using GridDescriptor = typename AbstractSolver<Grid>::GridDescriptor;
-    using Bitset = typename AbstractSolver<Grid>::Bitset;
-    using Integer = typename AbstractSolver<Grid>::Integer;
+    using GridDescriptor = typename AbstractSolver<Grid, Descriptor>::GridDescriptor;
+    using Bitset = typename AbstractSolver<Grid, Descriptor>::Bitset;
+    using Integer = typename AbstractSolver<Grid, Descriptor>::Integer;
+    using Changes = typename AbstractSolver<Grid, Descriptor>::Changes;
 
     bool solveOnce(GridDescriptor& gridDescriptor) override
     {
-        Bitset const singles = findNakedSingles(gridDescriptor);
-        if (singles.none())
-        {
-            return false;
-        }
+        return solveNakedSingles(gridDescriptor, findNakedSingles(gridDescriptor));
+    }
 
-        solveNakedSingles(gridDescriptor, singles);
+    // Singles found by the last run were all placed, so new ones can only be among the changed cells
+    bool solveChanged(GridDescriptor& gridDescriptor, Changes const& changes) override
+    {
+        return solveNakedSingles(gridDescriptor, findNakedSingles(gridDescriptor, changes.cells));
+    }
 
+    bool usesChanges() const override
+    {
         return true;
     }
 
@@ -50,15 +57,55 @@ private:
         return nakedSingles;
     }
 
-    void solveNakedSingles(GridDescriptor& gridDescriptor, Bitset const& nakedSingles) const
+    // Reads the candidates of each cell one bit at a time, which beats masking the whole grid for a few cells
+    template<typename CellSet>
+    Bitset findNakedSingles(GridDescriptor const& gridDescriptor, CellSet const& cells) const
     {
+        Bitset nakedSingles{};
+
+        for (auto const cell : setBits(cells))
+        {
+            // Placing a value clears all the missing bits of its cell
+            if (!gridDescriptor.missingValuesMask().test(GridDescriptor::bitIndex(cell, 1)))
+            {
+                continue;
+            }
+
+            std::size_t candidateCount = 0;
+            std::size_t singleBit = 0;
+            for (Integer value = 1; (value <= Grid::maxValue) && (candidateCount < 2); ++value)
+            {
+                std::size_t const bit = GridDescriptor::bitIndex(cell, value);
+                if (gridDescriptor.possibilities().test(bit))
+                {
+                    ++candidateCount;
+                    singleBit = bit;
+                }
+            }
+
+            if (candidateCount == 1)
+            {
+                nakedSingles.set(singleBit);
+            }
+        }
+
+        return nakedSingles;
+    }
+
+    bool solveNakedSingles(GridDescriptor& gridDescriptor, Bitset const& nakedSingles) const
+    {
+        if (nakedSingles.none())
+        {
+            return false;
+        }
+
         Bitset impossibilities{};
         Bitset cells{};
 
-        for (auto it = SetBitIterator{ nakedSingles }; it != SetBitIterator<Bitset>{}; ++it)
+        for (auto const bit : setBits(nakedSingles))
         {
-            auto const cell = *it / Grid::maxValue;
-            auto const value = 1 + (*it % Grid::maxValue);
+            auto const cell = GridDescriptor::bitToCell(bit);
+            auto const value = GridDescriptor::bitToValue(bit);
             impossibilities |= gridDescriptor.cellHousesMask(cell) & gridDescriptor.valueMask(value);
             cells |= gridDescriptor.cellMask(cell);
         }
@@ -67,5 +114,51 @@ private:
 
         gridDescriptor.missingValuesMask() &= ~cells;
         gridDescriptor.possibilities() &= ~impossibilities;
+        return true;
+    }
+};
+
+template<typename Grid>
+class NakedSingleSolver<Grid, CompactSudokuDescriptor<Grid>> : public AbstractSolver<Grid, CompactSudokuDescriptor<Grid>>
+{
+public:
+    using GridDescriptor = CompactSudokuDescriptor<Grid>;
+    using Candidates = typename GridDescriptor::Candidates;
+
+    bool solveOnce(GridDescriptor& gridDescriptor) override
+    {
+        std::array<Candidates, Grid::cellCount> const singles = findNakedSingles(gridDescriptor);
+
+        bool found = false;
+        for (std::size_t cell = 0; cell < Grid::cellCount; ++cell)
+        {
+            // A previous placement may have removed the single's only candidate
+            if ((singles[cell] != 0) && (gridDescriptor.candidates(cell) == singles[cell]))
+            {
+                gridDescriptor.setValue(cell, GridDescriptor::bitToValue(singles[cell]));
+                found = true;
+            }
+        }
+
+        return found;
+    }
+
+private:
+    // Candidate word of every unsolved cell having exactly one candidate, 0 elsewhere.
+    // Branch-free over the contiguous candidate array so that it vectorizes.
+    std::array<Candidates, Grid::cellCount> findNakedSingles(GridDescriptor const& gridDescriptor) const
+    {
+        std::array<Candidates, Grid::cellCount> singles{};
+        auto const& candidates = gridDescriptor.candidates();
+
+        for (std::size_t cell = 0; cell < Grid::cellCount; ++cell)
+        {
+            Candidates const cellCandidates = candidates[cell];
+            bool const isSingle = (gridDescriptor.value(cell) == 0)
+                                & ((cellCandidates & static_cast<Candidates>(cellCandidates - 1)) == 0);
+            singles[cell] = isSingle ? cellCandidates : Candidates{};
+        }
+
+        return singles;
     }
 };
@@ -0,0 +1,200 @@
+// Copyright 2022 DrSinIsIn (axel.gaillard.dev@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <span>
+
+#include "AbstractSolver.h"
+#include "Utility/GridTopology.h"
+#include "Utility/MathUtils.h"
+#include "Utility/SetBitIterator.h"
+
+// tupleSize unsolved cells of a house whose candidates all lie among tupleSize values hold these values, which are
+// removed from the house's other cells.
+template<std::size_t tupleSize, typename Grid, typename Descriptor = SudokuDescriptor<Grid>>
+    requires (tupleSize > 1)
+          && (tupleSize < Grid::columnCount)
+class NakedTupleSolver : public AbstractSolver<Grid, Descriptor>
+{
+public:
+    using GridDescriptor = typename AbstractSolver<Grid, Descriptor>::GridDescriptor;
+    using Bitset = typename AbstractSolver<Grid, Descriptor>::Bitset;
+    using Integer = typename AbstractSolver<Grid, Descriptor>::Integer;
+    using Changes = typename AbstractSolver<Grid, Descriptor>::Changes;
+    using Topology = GridTopology<Grid>;
+
+    bool solveOnce(GridDescriptor& gridDescriptor) override
+    {
+        bool found = false;
+
+        for (std::size_t house = 0; house < Topology::houseCount; ++house)
+        {
+            found |= solveNakedTuplesFor(gridDescriptor, house);
+        }
+
+        return found;
+    }
+
+    // Tuples only depend on the candidates of their house
+    bool solveChanged(GridDescriptor& gridDescriptor, Changes const& changes) override
+    {
+        bool found = false;
+
+        for (auto const house : setBits(changes.houses))
+        {
+            found |= solveNakedTuplesFor(gridDescriptor, house);
+        }
+
+        return found;
+    }
+
+    bool usesChanges() const override
+    {
+        return true;
+    }
+
+private:
+    // One bit per value, value v being bit v - 1
+    using Values = typename Topology::HousePositions;
+
+    static constexpr Values bit(std::size_t index) noexcept
+    {
+        return static_cast<Values>(Values{ 1 } << index);
+    }
+
+    using Combinations = MathUtils::BoundedUnionCombinations<tupleSize, Values>;
+
+    // Candidates of the unsolved cells of a house
+    struct HouseCandidates
+    {
+        std::size_t house{};
+        std::array<std::size_t, Grid::maxValue> openCells{}; // Positions in the house
+        std::array<Values, Grid::maxValue> openCellValues{}; // Candidates of each open cell
+        std::size_t openCellCount{};
+        std::array<std::size_t, Grid::maxValue> tupleCells{}; // Indices of the open cells that may be in a tuple
+        std::array<Values, Grid::maxValue> tupleCellValues{};
+        std::size_t tupleCellCount{};
+    };
+
+    bool solveNakedTuplesFor(GridDescriptor& descriptor, std::size_t house) const
+    {
+        HouseCandidates candidates = gatherCandidates(descriptor, house);
+
+        // k cells among k or fewer open ones leave no other cell to remove values from
+        if ((candidates.openCellCount <= tupleSize) || (candidates.tupleCellCount < tupleSize))
+        {
+            return false;
+        }
+
+        bool hasSolved = false;
+
+        // Cells whose candidates spread over more than tupleSize values can't be part of a tuple
+        std::span<Values const> const values{ candidates.tupleCellValues.data(), candidates.tupleCellCount };
+        for (auto const& tuple : Combinations{ values, tupleSize })
+        {
+            if (static_cast<std::size_t>(std::popcount(tuple.unionMask)) == tupleSize)
+            {
+                hasSolved |= removeFromOthers(descriptor, candidates, tuple);
+            }
+        }
+
+        return hasSolved;
+    }
+
+    static HouseCandidates gatherCandidates(GridDescriptor const& descriptor, std::size_t house)
+    {
+        HouseCandidates candidates{ house };
+
+        auto const& possibilities = descriptor.possibilities();
+        for (std::size_t position = 0; auto cell : Topology::houseCells[house])
+        {
+            // Placing a value clears all the missing bits of its cell
+            if (descriptor.missingValuesMask().test(GridDescriptor::bitIndex(cell, 1)))
+            {
+                Values values{};
+                for (Integer value = 1; value <= Grid::maxValue; ++value)
+                {
+                    if (possibilities.test(GridDescriptor::bitIndex(cell, value)))
+                    {
+                        values |= bit(value - 1);
+                    }
+                }
+
+                // Cells with a single candidate are singles, and cells with none only show a contradiction
+                auto const valueCount = static_cast<std::size_t>(std::popcount(values));
+                if ((valueCount > 1) && (valueCount <= tupleSize))
+                {
+                    candidates.tupleCells[candidates.tupleCellCount] = candidates.openCellCount;
+                    candidates.tupleCellValues[candidates.tupleCellCount] = values;
+                    ++candidates.tupleCellCount;
+                }
+
+                candidates.openCells[candidates.openCellCount] = position;
+                candidates.openCellValues[candidates.openCellCount] = values;
+                ++candidates.openCellCount;
+            }
+            ++position;
+        }
+
+        return candidates;
+    }
+
+    // The tuple's cells hold the tuple's values, which are removed from the other open cells
+    static bool removeFromOthers(GridDescriptor& descriptor
+                               , HouseCandidates& candidates
+                               , typename Combinations::Combination const& tuple)
+    {
+        std::array<std::size_t, tupleSize> tupleOpenCells{};
+        std::ranges::transform(tuple.indices, tupleOpenCells.begin(), [&](std::size_t index)
+        {
+            return candidates.tupleCells[index];
+        });
+
+        bool hasSolved = false;
+
+        auto const& cells = Topology::houseCells[candidates.house];
+        for (std::size_t i = 0; i < candidates.openCellCount; ++i)
+        {
+            Values& values = candidates.openCellValues[i];
+            Values removed = values & tuple.unionMask;
+            if ((removed == 0) || (std::ranges::find(tupleOpenCells, i) != tupleOpenCells.end()))
+            {
+                continue;
+            }
+
+            auto const cell = cells[candidates.openCells[i]];
+            for (; removed != 0; removed &= static_cast<Values>(removed - 1))
+            {
+                auto const value = static_cast<Integer>(std::countr_zero(removed) + 1);
+                descriptor.possibilities().reset(GridDescriptor::bitIndex(cell, value));
+            }
+
+            values &= static_cast<Values>(~tuple.unionMask);
+            hasSolved = true;
+        }
+
+        // Later combinations see the cells as they are now
+        for (std::size_t i = 0; i < candidates.tupleCellCount; ++i)
+        {
+            candidates.tupleCellValues[i] = candidates.openCellValues[candidates.tupleCells[i]];
+        }
+
+        return hasSolved;
+    }
+};
+
+template<typename Grid, typename Descriptor = SudokuDescriptor<Grid>>
+using NakedPairSolver = NakedTupleSolver<2, Grid, Descriptor>;
+
+template<typename Grid, typename Descriptor = SudokuDescriptor<Grid>>
+using NakedTripleSolver = NakedTupleSolver<3, Grid, Descriptor>;
+
+template<typename Grid, typename Descriptor = SudokuDescriptor<Grid>>
+using NakedQuadSolver = NakedTupleSolver<4, Grid, Descriptor>;
@@ -0,0 +1,314 @@
+// Copyright 2022 DrSinIsIn (axel.gaillard.dev@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "BatchSolving.h"
+#include "DancingLinksSolver.h"
+#include "Utility/CandidateTrail.h"
+#include "Utility/SudokuDescriptor.h"
+
+// Cells whose clues are kept or removed together
+enum class ClueSymmetry
+{
+    None,
+    Rotational, // Half turn around the center of the grid
+    Mirror,     // Left and right halves
+    Diagonal,   // Sides of the main diagonal
+};
+
+struct GenerationOptions
+{
+    std::uint64_t seed = 0;
+    ClueSymmetry symmetry = ClueSymmetry::None;
+};
+
+namespace details
+{
+    // Seed of the index-th puzzle of a batch (splitmix64), so that it doesn't depend on which worker generates it
+    constexpr std::uint64_t puzzleSeed(std::uint64_t seed, std::size_t index) noexcept
+    {
+        std::uint64_t z = seed + ((static_cast<std::uint64_t>(index) + 1) * 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+}
+
+// Random puzzles with a unique solution. A full grid is first filled by guessing candidates in random order, always in
+// the cell with the fewest left, backtracking on contradictions; clues are then removed one symmetry orbit at a time,
+// in random order, as long as the puzzle keeps a single solution. Everything runs on one descriptor recording its
+// changes to a trail: guesses and uniqueness checks are rolled back rather than rebuilt from a grid, and the clues
+// not tried yet stay placed between checks. Strategies aren't run: on these grids, they cost more than the exact
+// cover search they would spare.
+// Puzzles only depend on the seed (mt19937_64 and our own shuffles, not the standard distributions whose results
+// differ between standard libraries). A generator holds scratch state: use one per thread, or generateBatch.
+template<typename Grid, typename Descriptor = TrailedSudokuDescriptor<Grid>>
+class PuzzleGenerator
+{
+public:
+    using GridDescriptor = Descriptor;
+    using Integer = typename Grid::Integer;
+
+    explicit PuzzleGenerator(std::uint64_t seed = 0)
+        : m_random{ seed }
+    {}
+
+    void seed(std::uint64_t seed)
+    {
+        m_random.seed(seed);
+    }
+
+    Grid generate(ClueSymmetry symmetry = ClueSymmetry::None)
+    {
+        return removeClues(fullGrid(), symmetry);
+    }
+
+    // Random solved grid
+    Grid fullGrid()
+    {
+        GridDescriptor descriptor{ Grid{} };
+        descriptor.setTrail(&m_trail);
+        [[maybe_unused]] bool const isFilled = fill(descriptor);
+        assert(isFilled);
+
+        descriptor.setTrail(nullptr);
+        m_trail.clear();
+        return descriptor;
+    }
+
+    // Puzzle whose only solution is the given solved grid, from which no orbit of clues can be removed anymore
+    Grid removeClues(Grid const& solution, ClueSymmetry symmetry = ClueSymmetry::None)
+    {
+        auto orbits = clueOrbits(symmetry);
+        shuffle(std::span{ orbits });
+
+        // Orbits are placed from the last one down with a mark before each, so that rolling back to the mark of an
+        // orbit leaves every later one placed: only the clues kept so far need placing again on top of them
+        GridDescriptor descriptor{ Grid{} };
+        descriptor.setTrail(&m_trail);
+
+        std::vector<CandidateTrail::Mark> marks(orbits.size());
+        for (std::size_t i = orbits.size(); i-- > 0;)
+        {
+            marks[i] = m_trail.mark();
+            place(descriptor, solution, orbits[i]);
+        }
+
+        Grid puzzle = solution;
+        std::vector<std::size_t> keptOrbits;
+        for (std::size_t i = 0; i < orbits.size(); ++i)
+        {
+            m_trail.rollback(marks[i]);
+            for (auto const kept : keptOrbits)
+            {
+                place(descriptor, solution, orbits[kept]);
+            }
+
+            if (isOnlySolution(descriptor, solution, orbits[i]))
+            {
+                for (auto const cell : orbits[i])
+                {
+                    *(puzzle.begin() + static_cast<std::ptrdiff_t>(cell)) = 0;
+                }
+            }
+            else
+            {
+                keptOrbits.push_back(i);
+            }
+        }
+
+        descriptor.setTrail(nullptr);
+        m_trail.clear();
+        return puzzle;
+    }
+
+private:
+    // One or two cells, the second one being the first one when alone
+    using Orbit = std::array<std::size_t, 2>;
+
+    std::mt19937_64 m_random;
+    CandidateTrail m_trail;
+
+    // Uniform enough for bounds far below 2^64
+    std::size_t randomBelow(std::size_t bound)
+    {
+        return static_cast<std::size_t>(m_random() % bound);
+    }
+
+    template<typename T>
+    void shuffle(std::span<T> values)
+    {
+        for (std::size_t i = values.size(); i > 1; --i)
+        {
+            std::swap(values[i - 1], values[randomBelow(i)]);
+        }
+    }
+
+    bool fill(GridDescriptor& descriptor)
+    {
+        if (descriptor.isContradiction())
+        {
+            return false;
+        }
+
+        if (descriptor.isFilled())
+        {
+            return true;
+        }
+
+        std::size_t const cell = findMostConstrainedCell(descriptor);
+        std::array<Integer, Grid::maxValue> values{};
+        std::size_t valueCount = 0;
+        for (Integer value = 1; value <= Grid::maxValue; ++value)
+        {
+            if (descriptor.possibilities().test(GridDescriptor::bitIndex(cell, value)))
+            {
+                values[valueCount++] = value;
+            }
+        }
+        shuffle(std::span{ values.data(), valueCount });
+
+        for (std::size_t i = 0; i < valueCount; ++i)
+        {
+            auto const mark = m_trail.mark();
+            descriptor.setValue(cell, values[i]);
+            if (fill(descriptor))
+            {
+                return true;
+            }
+            m_trail.rollback(mark);
+        }
+
+        return false;
+    }
+
+    // Unsolved cell with the fewest possibilities, the descriptor being free of contradictions
+    static std::size_t findMostConstrainedCell(GridDescriptor const& descriptor)
+    {
+        std::size_t bestCell = 0;
+        std::size_t bestCount = Grid::maxValue + 1;
+        for (std::size_t cell = 0; cell < Grid::cellCount; ++cell)
+        {
+            // Placing a value clears all the missing bits of its cell
+            if (!descriptor.missingValuesMask().test(GridDescriptor::bitIndex(cell, 1)))
+            {
+                continue;
+            }
+
+            std::size_t count = 0;
+            for (Integer value = 1; value <= Grid::maxValue; ++value)
+            {
+                count += descriptor.possibilities().test(GridDescriptor::bitIndex(cell, value)) ? 1 : 0;
+            }
+
+            if (count < bestCount)
+            {
+                bestCell = cell;
+                bestCount = count;
+                if (count <= 2)
+                {
+                    break;
+                }
+            }
+        }
+
+        return bestCell;
+    }
+
+    // The solution solves the puzzle left without the orbit's clues, and is the only one when no solution has
+    // another value in one of the orbit's cells: each search rules the solution's value out of a cell, which prunes
+    // more than counting up to two solutions would, and stops at the first solution found.
+    bool isOnlySolution(GridDescriptor& descriptor, Grid const& solution, Orbit const& orbit)
+    {
+        std::size_t const cellCount = (orbit[0] == orbit[1]) ? 1 : 2;
+        for (std::size_t i = 0; i < cellCount; ++i)
+        {
+            auto const cell = orbit[i];
+            auto const value = *(solution.begin() + static_cast<std::ptrdiff_t>(cell));
+            auto const mark = m_trail.mark();
+            descriptor.possibilities().reset(GridDescriptor::bitIndex(cell, value));
+            bool const hasOtherSolution = DancingLinksSolver<Grid, Descriptor>::countSolutions(descriptor, 1) > 0;
+            m_trail.rollback(mark);
+
+            if (hasOtherSolution)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    static void place(GridDescriptor& descriptor, Grid const& solution, Orbit const& orbit)
+    {
+        for (auto const cell : orbit)
+        {
+            // The second cell of a lone cell's orbit is already placed
+            if (descriptor.missingValuesMask().test(GridDescriptor::bitIndex(cell, 1)))
+            {
+                descriptor.setValue(cell, *(solution.begin() + static_cast<std::ptrdiff_t>(cell)));
+            }
+        }
+    }
+
+    static std::size_t symmetricCell(std::size_t cell, ClueSymmetry symmetry)
+    {
+        auto const [x, y] = Grid::cellToCoordinates(cell);
+        switch (symmetry)
+        {
+        case ClueSymmetry::Rotational:
+            return Grid::coordinatesToCell(Grid::columnCount - 1 - x, Grid::rowCount - 1 - y);
+        case ClueSymmetry::Mirror:
+            return Grid::coordinatesToCell(Grid::columnCount - 1 - x, y);
+        case ClueSymmetry::Diagonal:
+            return Grid::coordinatesToCell(y, x);
+        case ClueSymmetry::None:
+            break;
+        }
+
+        return cell;
+    }
+
+    static std::vector<Orbit> clueOrbits(ClueSymmetry symmetry)
+    {
+        std::vector<Orbit> orbits;
+        for (std::size_t cell = 0; cell < Grid::cellCount; ++cell)
+        {
+            std::size_t const other = symmetricCell(cell, symmetry);
+            if (other >= cell)
+            {
+                orbits.push_back(Orbit{ cell, other });
+            }
+        }
+
+        return orbits;
+    }
+};
+
+// Fills out with puzzles generated from options, spread over the threads of batchOptions. out[i] only depends on
+// options and i: it is PuzzleGenerator{ details::puzzleSeed(options.seed, i) }.generate(options.symmetry).
+template<typename Grid, typename Descriptor = TrailedSudokuDescriptor<Grid>>
+void generateBatch(std::span<Grid> out, GenerationOptions const& options = {}, BatchOptions const& batchOptions = {})
+{
+    details::runWorkers(out.size(), batchOptions, [&](std::size_t worker, details::WorkStealingRanges& ranges)
+    {
+        PuzzleGenerator<Grid, Descriptor> generator;
+        while (auto const index = ranges.next(worker))
+        {
+            generator.seed(details::puzzleSeed(options.seed, *index));
+            out[*index] = generator.generate(options.symmetry);
+        }
+    });
+}
@@ -0,0 +1,83 @@
+// Copyright 2022 DrSinIsIn (axel.gaillard.dev@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cstddef>
+
+#include "DancingLinksSolver.h"
+#include "HiddenTupleSolver.h"
+#include "LockedCandidatesSolver.h"
+#include "NakedSingleSolver.h"
+#include "StrategyChain.h"
+
+// Counts the solutions of puzzles up to a limit: singles and locked candidates first remove what they can, then the
+// exact cover search enumerates the completions of what is left, stopping as soon as limit of them are found.
+// These strategies only remove candidates belonging to no solution, so the count is the puzzle's own, and the search
+// only pays for the cells logic left open. A counter keeps its strategies between calls; use one per thread.
+template<typename Grid, typename Descriptor = SudokuDescriptor<Grid>>
+class SolutionCounter
+{
+public:
+    using GridDescriptor = Descriptor;
+
+    std::size_t count(Grid const& grid, std::size_t limit)
+    {
+        GridDescriptor descriptor{ grid };
+        return countPropagated(descriptor, limit);
+    }
+
+    std::size_t count(GridDescriptor descriptor, std::size_t limit)
+    {
+        return countPropagated(descriptor, limit);
+    }
+
+    // Same, leaving the descriptor as propagated by the strategies, which is as far as logic alone gets
+    std::size_t countPropagated(GridDescriptor& descriptor, std::size_t limit)
+    {
+        if (limit == 0)
+        {
+            return 0;
+        }
+
+        // Strategies keep every solution, so a contradiction after them means there is none
+        m_propagator.solve(descriptor);
+        if (descriptor.isContradiction())
+        {
+            return 0;
+        }
+
+        if (descriptor.isFilled())
+        {
+            return 1;
+        }
+
+        return DancingLinksSolver<Grid, Descriptor>::countSolutions(descriptor, limit);
+    }
+
+    // The search stops at the second solution
+    bool hasUniqueSolution(Grid const& grid)
+    {
+        return count(grid, 2) == 1;
+    }
+
+private:
+    StrategyChain<NakedSingleSolver<Grid, Descriptor>
+                , HiddenSingleSolver<Grid, Descriptor>
+                , LockedCandidatesSolver<Grid, Descriptor>> m_propagator;
+};
+
+// Number of solutions of grid, counting up to limit
+template<typename Grid, typename Descriptor = SudokuDescriptor<Grid>>
+std::size_t countSolutions(Grid const& grid, std::size_t limit)
+{
+    return SolutionCounter<Grid, Descriptor>{}.count(grid, limit);
+}
+
+template<typename Grid, typename Descriptor = SudokuDescriptor<Grid>>
+bool hasUniqueSolution(Grid const& grid)
+{
+    return SolutionCounter<Grid, Descriptor>{}.hasUniqueSolution(grid);
+}
@@ -0,0 +1,201 @@
+// Copyright 2022 DrSinIsIn (axel.gaillard.dev@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "AbstractSolver.h"
+#include "Utility/SetBitIterator.h"
+
+namespace details
+{
+    // Descriptors whose candidates can be compared to an earlier copy, to tell what changed since
+    template<typename Descriptor>
+    concept CandidateBitsets = requires(Descriptor const& descriptor, std::size_t bit)
+    {
+        { descriptor.possibilities() ^ descriptor.missingValuesMask() };
+        { Descriptor::bitToCell(bit) } -> std::convertible_to<std::size_t>;
+        { Descriptor::bitToValue(bit) } -> std::convertible_to<std::size_t>;
+    };
+} // namespace details
+
+// Runs an ordered list of strategies until none of them makes progress anymore or the grid is filled.
+// Strategies are expected to be added from the cheapest to the most expensive one: any progress restarts
+// the pass from the first strategy, so that costly strategies only run when every cheaper one is stuck.
+// Strategies that use changes are handed what changed since they last ran, and skipped when nothing did. What changed
+// is found by comparing the candidates to a copy taken at the last progress, so strategies pay nothing for it.
+template<typename Grid, typename Descriptor = SudokuDescriptor<Grid>>
+class SolverPipeline : public AbstractSolver<Grid, Descriptor>
+{
+public:
+    using GridDescriptor = typename AbstractSolver<Grid, Descriptor>::GridDescriptor;
+    using Bitset = typename AbstractSolver<Grid, Descriptor>::Bitset;
+    using Integer = typename AbstractSolver<Grid, Descriptor>::Integer;
+    using Changes = typename AbstractSolver<Grid, Descriptor>::Changes;
+    using SolverPointer = std::unique_ptr<AbstractSolver<Grid, Descriptor>>;
+
+    struct Report
+    {
+        // Number of times each strategy made progress, in pipeline order
+        std::vector<std::size_t> applicationCounts;
+        bool filled = false;
+
+        bool hasProgressed() const
+        {
+            return std::ranges::any_of(applicationCounts, std::identity{});
+        }
+    };
+
+    template<std::derived_from<AbstractSolver<Grid, Descriptor>> Solver, typename... Args>
+    Solver& add(Args&&... args)
+    {
+        auto solver = std::make_unique<Solver>(std::forward<Args>(args)...);
+        Solver& result = *solver;
+        add(std::move(solver));
+        return result;
+    }
+
+    void add(SolverPointer solver)
+    {
+        bool const usesChanges = details::CandidateBitsets<GridDescriptor> && solver->usesChanges();
+        m_usesChanges.push_back(usesChanges);
+        m_pendingChanges.emplace_back();
+        m_tracksChanges |= usesChanges;
+        m_solvers.push_back(std::move(solver));
+    }
+
+    std::size_t size() const noexcept
+    {
+        return m_solvers.size();
+    }
+
+    AbstractSolver<Grid, Descriptor>& operator[](std::size_t index)
+    {
+        return *m_solvers[index];
+    }
+
+    AbstractSolver<Grid, Descriptor> const& operator[](std::size_t index) const
+    {
+        return *m_solvers[index];
+    }
+
+    Report solve(GridDescriptor& gridDescriptor)
+    {
+        Report report{ std::vector<std::size_t>(m_solvers.size()) };
+        run(gridDescriptor, [&](std::size_t index) { ++report.applicationCounts[index]; });
+
+        report.filled = gridDescriptor.isFilled();
+        return report;
+    }
+
+    // Same fixpoint as solve, without counting applications: search runs it at every node
+    bool solveOnce(GridDescriptor& gridDescriptor) override
+    {
+        bool progressed = false;
+        run(gridDescriptor, [&](std::size_t) { progressed = true; });
+        return progressed;
+    }
+
+private:
+    std::vector<SolverPointer> m_solvers;
+    std::vector<bool> m_usesChanges;
+    std::vector<Changes> m_pendingChanges; // Per strategy using changes, what changed since it last ran
+    bool m_tracksChanges = false;
+
+    // Candidates at the last progress
+    Bitset m_lastPossibilities{};
+    Bitset m_lastMissingValues{};
+
+    // Calls onProgress with the index of each strategy that progressed
+    template<typename OnProgress>
+    void run(GridDescriptor& gridDescriptor, OnProgress&& onProgress)
+    {
+        if (m_tracksChanges)
+        {
+            std::ranges::fill(m_pendingChanges, Changes::everything());
+            takeCandidates(gridDescriptor);
+        }
+
+        for (std::size_t i = 0; (i < m_solvers.size()) && !gridDescriptor.isFilled();)
+        {
+            if (apply(i, gridDescriptor))
+            {
+                onProgress(i);
+                i = 0;
+            }
+            else
+            {
+                ++i;
+            }
+        }
+    }
+
+    bool apply(std::size_t index, GridDescriptor& gridDescriptor)
+    {
+        if (!m_usesChanges[index])
+        {
+            bool const progressed = m_solvers[index]->solveOnce(gridDescriptor);
+            if (progressed && m_tracksChanges)
+            {
+                recordChanges(gridDescriptor);
+            }
+            return progressed;
+        }
+
+        // The strategy found nothing more when it last ran, so without changes there is nothing to find
+        if (m_pendingChanges[index].none())
+        {
+            return false;
+        }
+
+        Changes const changes = m_pendingChanges[index];
+        m_pendingChanges[index] = Changes{};
+        bool const progressed = m_solvers[index]->solveChanged(gridDescriptor, changes);
+        if (progressed)
+        {
+            recordChanges(gridDescriptor);
+        }
+        return progressed;
+    }
+
+    // Hands what changed since the last progress to every strategy using changes
+    void recordChanges(GridDescriptor const& gridDescriptor)
+    {
+        if constexpr (details::CandidateBitsets<GridDescriptor>)
+        {
+            Changes changes;
+            for (auto const bit : setBits((gridDescriptor.possibilities() ^ m_lastPossibilities)
+                                        | (gridDescriptor.missingValuesMask() ^ m_lastMissingValues)))
+            {
+                changes.add(GridDescriptor::bitToCell(bit), GridDescriptor::bitToValue(bit));
+            }
+
+            for (std::size_t i = 0; i < m_solvers.size(); ++i)
+            {
+                if (m_usesChanges[i])
+                {
+                    m_pendingChanges[i] |= changes;
+                }
+            }
+
+            takeCandidates(gridDescriptor);
+        }
+    }
+
+    void takeCandidates(GridDescriptor const& gridDescriptor)
+    {
+        if constexpr (details::CandidateBitsets<GridDescriptor>)
+        {
+            m_lastPossibilities = gridDescriptor.possibilities();
+            m_lastMissingValues = gridDescriptor.missingValuesMask();
+        }
+    }
+};
@@ -0,0 +1,116 @@
+// Copyright 2022 DrSinIsIn (axel.gaillard.dev@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <utility>
+
+#include "AbstractSolver.h"
+
+namespace details
+{
+    template<typename Grid, typename Descriptor>
+    Grid solverGrid(AbstractSolver<Grid, Descriptor> const*);
+
+    template<typename Solver>
+    using SolverGrid = decltype(solverGrid(static_cast<Solver const*>(nullptr)));
+
+    template<typename Solver>
+    using SolverDescriptor = typename Solver::GridDescriptor;
+}
+
+// Same run-to-fixpoint semantics as SolverPipeline, with the strategies fixed at compile time: every call goes
+// straight to the strategy's own solveOnce, which lets the compiler inline it into the loop. The chain itself
+// is still an AbstractSolver, so that it can be used as a BacktrackingSolver propagator or pipeline step.
+template<typename FirstSolver, typename... OtherSolvers>
+    requires (std::same_as<details::SolverDescriptor<FirstSolver>, details::SolverDescriptor<OtherSolvers>> && ...)
+class StrategyChain final
+    : public AbstractSolver<details::SolverGrid<FirstSolver>, details::SolverDescriptor<FirstSolver>>
+{
+    using Base = AbstractSolver<details::SolverGrid<FirstSolver>, details::SolverDescriptor<FirstSolver>>;
+
+public:
+    using GridDescriptor = typename Base::GridDescriptor;
+    using Bitset = typename Base::Bitset;
+    using Integer = typename Base::Integer;
+
+    static constexpr std::size_t strategyCount = 1 + sizeof...(OtherSolvers);
+
+    struct Report
+    {
+        // Number of times each strategy made progress, in chain order
+        std::array<std::size_t, strategyCount> applicationCounts{};
+        bool filled = false;
+
+        bool hasProgressed() const
+        {
+            return std::ranges::any_of(applicationCounts, std::identity{});
+        }
+    };
+
+    StrategyChain() = default;
+
+    explicit StrategyChain(FirstSolver firstSolver, OtherSolvers... otherSolvers)
+        : m_solvers{ std::move(firstSolver), std::move(otherSolvers)... }
+    {}
+
+    template<std::size_t index>
+    auto& get() noexcept
+    {
+        return std::get<index>(m_solvers);
+    }
+
+    Report solve(GridDescriptor& gridDescriptor)
+    {
+        Report report;
+
+        while (!gridDescriptor.isFilled() && applyFirstProgressing(gridDescriptor, report))
+        {
+        }
+
+        report.filled = gridDescriptor.isFilled();
+        return report;
+    }
+
+    bool solveOnce(GridDescriptor& gridDescriptor) override
+    {
+        return solve(gridDescriptor).hasProgressed();
+    }
+
+private:
+    using Solvers = std::tuple<FirstSolver, OtherSolvers...>;
+
+    // Runs the strategies in order until one of them progresses
+    bool applyFirstProgressing(GridDescriptor& gridDescriptor, Report& report)
+    {
+        return [&]<std::size_t... indices>(std::index_sequence<indices...>)
+        {
+            return (apply<indices>(gridDescriptor, report) || ...);
+        }(std::make_index_sequence<strategyCount>{});
+    }
+
+    template<std::size_t index>
+    bool apply(GridDescriptor& gridDescriptor, Report& report)
+    {
+        using Solver = std::tuple_element_t<index, Solvers>;
+
+        // Qualified call, no virtual dispatch
+        if (std::get<index>(m_solvers).Solver::solveOnce(gridDescriptor))
+        {
+            ++report.applicationCounts[index];
+            return true;
+        }
+
+        return false;
+    }
+
+    Solvers m_solvers;
+};
@@ -0,0 +1,76 @@
+// Copyright 2022 DrSinIsIn (axel.gaillard.dev@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "AbstractSolver.h"
+
+// Counters filled by TimedSolver; one instance may be shared by the copies of a strategy running on
+// different threads.
+struct SolverStatistics
+{
+    std::atomic<std::uint64_t> callCount = 0;
+    std::atomic<std::uint64_t> progressCount = 0;
+    std::atomic<std::uint64_t> nanoseconds = 0;
+};
+
+// Decorator measuring how often and for how long the wrapped strategy runs
+template<typename Grid, typename Descriptor = SudokuDescriptor<Grid>>
+class TimedSolver : public AbstractSolver<Grid, Descriptor>
+{
+public:
+    using GridDescriptor = typename AbstractSolver<Grid, Descriptor>::GridDescriptor;
+    using Bitset = typename AbstractSolver<Grid, Descriptor>::Bitset;
+    using Integer = typename AbstractSolver<Grid, Descriptor>::Integer;
+    using Changes = typename AbstractSolver<Grid, Descriptor>::Changes;
+    using SolverPointer = std::unique_ptr<AbstractSolver<Grid, Descriptor>>;
+
+    // statistics must outlive this solver
+    TimedSolver(SolverPointer solver, SolverStatistics& statistics)
+        : m_solver{ std::move(solver) }
+        , m_statistics{ &statistics }
+    {}
+
+    bool solveOnce(GridDescriptor& gridDescriptor) override
+    {
+        return measure([&] { return m_solver->solveOnce(gridDescriptor); });
+    }
+
+    bool solveChanged(GridDescriptor& gridDescriptor, Changes const& changes) override
+    {
+        return measure([&] { return m_solver->solveChanged(gridDescriptor, changes); });
+    }
+
+    bool usesChanges() const override
+    {
+        return m_solver->usesChanges();
+    }
+
+private:
+    SolverPointer m_solver;
+    SolverStatistics* m_statistics;
+
+    template<typename Solve>
+    bool measure(Solve&& solve)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        bool const progressed = solve();
+        auto const duration = std::chrono::steady_clock::now() - start;
+
+        m_statistics->callCount.fetch_add(1, std::memory_order_relaxed);
+        m_statistics->progressCount.fetch_add(progressed ? 1 : 0, std::memory_order_relaxed);
+        m_statistics->nanoseconds.fetch_add(
+            static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count())
+          , std::memory_order_relaxed);
+
+        return progressed;
+    }
+};
@@ -0,0 +1,154 @@
+// Copyright 2022 DrSinIsIn (axel.gaillard.dev@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "CandidateLayout.h"
+#include "GridTopology.h"
+#include "StaticBitset.h"
+#include "SudokuDescriptor.h"
+
+// Candidates of laneCount puzzles in structure-of-arrays form: for each value, a plane of cellCount bits per
+// lane, where word w of every lane is stored contiguously so that an operation on a word runs on all lanes at
+// once. An empty lane has no candidates and no missing cell, which makes every strategy a no-op on it.
+template<typename Grid, std::size_t laneCount_>
+    requires (laneCount_ > 0)
+class BatchDescriptor
+{
+public:
+    using Integer = Grid::Integer;
+    using Topology = GridTopology<Grid>;
+    using CellSet = StaticBitset<Grid::cellCount>;
+    using Word = typename CellSet::Word;
+
+    static constexpr std::size_t laneCount = laneCount_;
+    static constexpr std::size_t planeWordCount = CellSet::wordCount;
+
+    using Lanes = std::array<Word, laneCount>;
+    using Plane = std::array<Lanes, planeWordCount>;
+
+    // House masks of the value-major SudokuDescriptor, as cell planes
+    static inline std::array<CellSet, Topology::houseCount> const housePlanes = []
+    {
+        using PlaneDescriptor = SudokuDescriptor<Grid, StaticBitset, ValueMajorLayout>;
+
+        std::array<CellSet, Topology::houseCount> result{};
+        for (std::size_t house = 0; house < Topology::houseCount; ++house)
+        {
+            result[house] = PlaneDescriptor::houseMask(house).template extract<Grid::cellCount>(0);
+        }
+
+        return result;
+    }();
+
+    static constexpr Word laneMask(bool condition) noexcept
+    {
+        return Word{} - static_cast<Word>(condition);
+    }
+
+public:
+    // Any SudokuDescriptor flavour
+    template<typename Descriptor>
+    void load(std::size_t lane, Descriptor const& descriptor)
+    {
+        for (Integer value = 1; value <= Grid::maxValue; ++value)
+        {
+            CellSet const cells = descriptor.valueCells(value);
+            for (std::size_t w = 0; w < planeWordCount; ++w)
+            {
+                m_candidates[value - 1][w][lane] = cells.word(w);
+            }
+        }
+
+        CellSet missingCells{};
+        for (std::size_t cell = 0; cell < Grid::cellCount; ++cell)
+        {
+            missingCells.set(cell, descriptor.missingValuesMask().test(Descriptor::bitIndex(cell, 1)));
+        }
+
+        for (std::size_t w = 0; w < planeWordCount; ++w)
+        {
+            m_missingCells[w][lane] = missingCells.word(w);
+        }
+    }
+
+    template<typename Descriptor = SudokuDescriptor<Grid>>
+    Descriptor store(std::size_t lane) const
+    {
+        Descriptor descriptor;
+        for (std::size_t cell = 0; cell < Grid::cellCount; ++cell)
+        {
+            std::size_t const w = cell / CellSet::wordWidth;
+            Word const bit = Word{ 1 } << (cell % CellSet::wordWidth);
+            bool const isMissing = (m_missingCells[w][lane] & bit) != 0;
+
+            for (Integer value = 1; value <= Grid::maxValue; ++value)
+            {
+                std::size_t const index = Descriptor::bitIndex(cell, value);
+                descriptor.possibilities().set(index, (m_candidates[value - 1][w][lane] & bit) != 0);
+                descriptor.missingValuesMask().set(index, isMissing);
+            }
+        }
+
+        return descriptor;
+    }
+
+    void clear(std::size_t lane)
+    {
+        for (auto& plane : m_candidates)
+        {
+            for (auto& word : plane)
+            {
+                word[lane] = 0;
+            }
+        }
+
+        for (auto& word : m_missingCells)
+        {
+            word[lane] = 0;
+        }
+    }
+
+    bool isFilled(std::size_t lane) const
+    {
+        Word missing = 0;
+        for (auto const& word : m_missingCells)
+        {
+            missing |= word[lane];
+        }
+
+        return missing == 0;
+    }
+
+    Plane& candidates(Integer value)
+    {
+        return m_candidates[value - 1];
+    }
+
+    Plane const& candidates(Integer value) const
+    {
+        return m_candidates[value - 1];
+    }
+
+    Plane& missingCells()
+    {
+        return m_missingCells;
+    }
+
+    Plane const& missingCells() const
+    {
+        return m_missingCells;
+    }
+
+    friend bool operator==(BatchDescriptor const&, BatchDescriptor const&) = default;
+
+private:
+    alignas(64) std::array<Plane, Grid::maxValue> m_candidates{};
+    alignas(64) Plane m_missingCells{};
+};
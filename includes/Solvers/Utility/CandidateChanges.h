@@ -0,0 +1,56 @@
+// Copyright 2022 DrSinIsIn (axel.gaillard.dev@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cstddef>
+
+#include "GridTopology.h"
+#include "StaticBitset.h"
+
+// Cells, houses and values whose candidates changed (removed candidates or placed values) since some point.
+// A house is changed when one of its cells is; a value is changed when one of its candidates is.
+template<typename Grid>
+struct CandidateChanges
+{
+    using Topology = GridTopology<Grid>;
+
+    StaticBitset<Grid::cellCount> cells{};
+    StaticBitset<Topology::houseCount> houses{};
+    StaticBitset<Grid::maxValue> values{}; // Value v is bit v - 1
+
+    // What strategies see when they have no previous state to compare to
+    static CandidateChanges everything()
+    {
+        CandidateChanges changes;
+        changes.cells.set();
+        changes.houses.set();
+        changes.values.set();
+        return changes;
+    }
+
+    bool none() const
+    {
+        return values.none();
+    }
+
+    void add(std::size_t cell, std::size_t value)
+    {
+        cells.set(cell);
+        values.set(value - 1);
+        for (auto house : Topology::cellHouses[cell])
+        {
+            houses.set(house);
+        }
+    }
+
+    CandidateChanges& operator|=(CandidateChanges const& other)
+    {
+        cells |= other.cells;
+        houses |= other.houses;
+        values |= other.values;
+        return *this;
+    }
+};
@@ -0,0 +1,54 @@
+// Copyright 2022 DrSinIsIn (axel.gaillard.dev@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cstddef>
+
+// Mapping between (cell, value) candidates and bit indices of a descriptor's bitsets
+
+// All values of a cell are contiguous: bit = cell * maxValue + (value - 1)
+template<typename Grid>
+struct CellMajorLayout
+{
+    static constexpr bool hasValuePlanes = false;
+
+    static constexpr std::size_t bitIndex(std::size_t cell, std::size_t value) noexcept
+    {
+        return (cell * Grid::maxValue) + (value - 1);
+    }
+
+    static constexpr std::size_t bitToCell(std::size_t bit) noexcept
+    {
+        return bit / Grid::maxValue;
+    }
+
+    static constexpr std::size_t bitToValue(std::size_t bit) noexcept
+    {
+        return 1 + (bit % Grid::maxValue);
+    }
+};
+
+// Each value has its own dense plane of cellCount bits: bit = (value - 1) * cellCount + cell
+template<typename Grid>
+struct ValueMajorLayout
+{
+    static constexpr bool hasValuePlanes = true;
+
+    static constexpr std::size_t bitIndex(std::size_t cell, std::size_t value) noexcept
+    {
+        return ((value - 1) * Grid::cellCount) + cell;
+    }
+
+    static constexpr std::size_t bitToCell(std::size_t bit) noexcept
+    {
+        return bit % Grid::cellCount;
+    }
+
+    static constexpr std::size_t bitToValue(std::size_t bit) noexcept
+    {
+        return 1 + (bit / Grid::cellCount);
+    }
+};
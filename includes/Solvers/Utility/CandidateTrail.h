@@ -0,0 +1,247 @@
+// Copyright 2022 DrSinIsIn (axel.gaillard.dev@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "StaticBitset.h"
+
+// Undo log of bitset words: each entry is a word and the value it had before being modified. Rolling back to a mark
+// restores the words modified since, in reverse order, so that it costs what was changed rather than what is stored.
+// Entries live in a single buffer whose capacity is kept across rollbacks, so deep searches stop allocating once
+// the trail has grown to their deepest path.
+class CandidateTrail
+{
+public:
+    using Word = details::BitsetKernels::Word;
+    using Mark = std::size_t;
+
+    CandidateTrail() = default;
+
+    explicit CandidateTrail(std::size_t capacity)
+    {
+        m_entries.reserve(capacity);
+    }
+
+    // The trail refers to the words it saved, which must outlive the trail or be rolled back first
+    CandidateTrail(CandidateTrail const&) = delete;
+    CandidateTrail& operator=(CandidateTrail const&) = delete;
+    CandidateTrail(CandidateTrail&&) = default;
+    CandidateTrail& operator=(CandidateTrail&&) = default;
+
+    constexpr void save(Word& word)
+    {
+        m_entries.push_back(Entry{ &word, word });
+    }
+
+    constexpr Mark mark() const noexcept
+    {
+        return m_entries.size();
+    }
+
+    constexpr std::size_t size() const noexcept
+    {
+        return m_entries.size();
+    }
+
+    // Restores every word saved after the mark
+    constexpr void rollback(Mark mark) noexcept
+    {
+        while (m_entries.size() > mark)
+        {
+            Entry const& entry = m_entries.back();
+            *entry.word = entry.previous;
+            m_entries.pop_back();
+        }
+    }
+
+    // Forgets the saved words, keeping their current value
+    constexpr void clear() noexcept
+    {
+        m_entries.clear();
+    }
+
+private:
+    struct Entry
+    {
+        Word* word;
+        Word previous;
+    };
+
+    std::vector<Entry> m_entries;
+};
+
+// StaticBitset saving the words it modifies to a trail, if it has one. Bitsets without a trail, such as copies and
+// the results of operators, behave like StaticBitset. The trail stays with the bitset: copies don't share it, and
+// assigning to a bitset with a trail saves the words it overwrites.
+template<std::size_t bitCount>
+class TrailedBitset : public StaticBitset<bitCount>
+{
+public:
+    using Base = StaticBitset<bitCount>;
+    using Word = typename Base::Word;
+
+    using Base::Base;
+
+    constexpr TrailedBitset() noexcept = default;
+
+    constexpr TrailedBitset(Base const& bits) noexcept
+        : Base{ bits }
+    {}
+
+    constexpr TrailedBitset(TrailedBitset const& other) noexcept
+        : Base{ other }
+    {}
+
+    constexpr TrailedBitset& operator=(TrailedBitset const& other)
+    {
+        return assign(other);
+    }
+
+    constexpr TrailedBitset& operator=(Base const& other)
+    {
+        return assign(other);
+    }
+
+    // nullptr stops recording
+    constexpr void setTrail(CandidateTrail* trail) noexcept
+    {
+        m_trail = trail;
+    }
+
+    constexpr CandidateTrail* trail() const noexcept
+    {
+        return m_trail;
+    }
+
+    constexpr TrailedBitset& set()
+    {
+        return assign(Base{}.set());
+    }
+
+    constexpr TrailedBitset& set(std::size_t index, bool value = true)
+    {
+        Word& word = Base::mutableWord(index / Base::wordWidth);
+        Word const bit = Word{ 1 } << (index % Base::wordWidth);
+        Word const updated = value ? (word | bit) : (word & ~bit);
+        if (updated != word)
+        {
+            if (m_trail)
+            {
+                m_trail->save(word);
+            }
+            word = updated;
+        }
+        return *this;
+    }
+
+    constexpr TrailedBitset& reset()
+    {
+        return assign(Base{});
+    }
+
+    constexpr TrailedBitset& reset(std::size_t index)
+    {
+        return set(index, false);
+    }
+
+    constexpr TrailedBitset& flip()
+    {
+        return assign(~static_cast<Base const&>(*this));
+    }
+
+    constexpr TrailedBitset& operator&=(Base const& other)
+    {
+        if (!m_trail)
+        {
+            Base::operator&=(other);
+            return *this;
+        }
+        return update(other, [](Word word, Word rhs) { return word & rhs; });
+    }
+
+    constexpr TrailedBitset& operator|=(Base const& other)
+    {
+        if (!m_trail)
+        {
+            Base::operator|=(other);
+            return *this;
+        }
+        return update(other, [](Word word, Word rhs) { return word | rhs; });
+    }
+
+    constexpr TrailedBitset& operator^=(Base const& other)
+    {
+        if (!m_trail)
+        {
+            Base::operator^=(other);
+            return *this;
+        }
+        return update(other, [](Word word, Word rhs) { return word ^ rhs; });
+    }
+
+    constexpr TrailedBitset& andNot(Base const& other)
+    {
+        if (!m_trail)
+        {
+            Base::andNot(other);
+            return *this;
+        }
+        return update(other, [](Word word, Word rhs) { return word & ~rhs; });
+    }
+
+    constexpr TrailedBitset& operator<<=(std::size_t shift)
+    {
+        return assign(static_cast<Base const&>(*this) << shift);
+    }
+
+    constexpr TrailedBitset& operator>>=(std::size_t shift)
+    {
+        return assign(static_cast<Base const&>(*this) >> shift);
+    }
+
+private:
+    CandidateTrail* m_trail = nullptr;
+
+    // Word by word, saving the words the operation modifies
+    template<typename Operation>
+    constexpr TrailedBitset& update(Base const& other, Operation operation)
+    {
+        for (std::size_t i = 0; i < Base::wordCount; ++i)
+        {
+            Word& word = Base::mutableWord(i);
+            Word const updated = operation(word, other.word(i));
+            if (updated != word)
+            {
+                m_trail->save(word);
+                word = updated;
+            }
+        }
+        return *this;
+    }
+
+    // Only the words that differ are saved and written
+    constexpr TrailedBitset& assign(Base const& bits)
+    {
+        if (!m_trail)
+        {
+            Base::operator=(bits);
+            return *this;
+        }
+
+        for (std::size_t i = 0; i < Base::wordCount; ++i)
+        {
+            Word& word = Base::mutableWord(i);
+            if (word != bits.word(i))
+            {
+                m_trail->save(word);
+                word = bits.word(i);
+            }
+        }
+        return *this;
+    }
+};
@@ -0,0 +1,192 @@
+// Copyright 2022 DrSinIsIn (axel.gaillard.dev@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include "GridTopology.h"
+#include "Sudoku.h"
+
+// Alternative to SudokuDescriptor storing one candidate word per cell (bit value - 1 set when value is still
+// possible) and, per house, the word of values already placed in it.
+template<typename Grid>
+class CompactSudokuDescriptor
+{
+public:
+    using Integer = Grid::Integer;
+    using Topology = GridTopology<Grid>;
+
+    // Grid::Integer is sized for the largest value, not for one bit per value (uint8_t for 9x9)
+    static constexpr std::uintmax_t allCandidatesValue = ((std::uintmax_t{ 1 } << (Grid::maxValue - 1)) * 2) - 1;
+
+    // Smallest unsigned integer holding one bit per value
+    using Candidates = typename details::FirstAccomodating<allCandidatesValue
+                                                         , std::uint8_t
+                                                         , std::uint16_t
+                                                         , std::uint32_t
+                                                         , std::uint64_t>::type;
+
+    // Lets strategies written against AbstractSolver name the per-cell word type
+    using Bitset = Candidates;
+
+    static constexpr Candidates allCandidates = static_cast<Candidates>(allCandidatesValue);
+
+    static constexpr Candidates valueBit(Integer value) noexcept
+    {
+        return static_cast<Candidates>(Candidates{ 1 } << (value - 1));
+    }
+
+    static constexpr Integer bitToValue(Candidates singleBit) noexcept
+    {
+        return static_cast<Integer>(1 + std::countr_zero(singleBit));
+    }
+
+public:
+    CompactSudokuDescriptor()
+    {
+        m_candidates.fill(allCandidates);
+    }
+
+    CompactSudokuDescriptor(Grid const& grid)
+        : CompactSudokuDescriptor()
+    {
+        for (std::size_t i = 0; Integer value : grid)
+        {
+            if (value > 0)
+            {
+                setValue(i, value);
+            }
+            ++i;
+        }
+    }
+
+    // From any SudokuDescriptor flavour
+    template<typename Descriptor>
+        requires requires(Descriptor const& descriptor) { descriptor.missingValuesMask(); }
+    explicit CompactSudokuDescriptor(Descriptor const& descriptor)
+    {
+        for (std::size_t cell = 0; cell < Grid::cellCount; ++cell)
+        {
+            Candidates candidates{};
+            for (Integer value = 1; value <= Grid::maxValue; ++value)
+            {
+                if (descriptor.possibilities().test(Descriptor::bitIndex(cell, value)))
+                {
+                    candidates |= valueBit(value);
+                }
+            }
+            m_candidates[cell] = candidates;
+
+            bool const isSolved = !descriptor.missingValuesMask().test(Descriptor::bitIndex(cell, 1));
+            if (isSolved && (std::popcount(candidates) == 1))
+            {
+                Integer const value = bitToValue(candidates);
+                m_values[cell] = value;
+                for (auto house : Topology::cellHouses[cell])
+                {
+                    m_placedValues[house] |= candidates;
+                }
+                --m_missingCount;
+            }
+        }
+    }
+
+    // To any SudokuDescriptor flavour
+    template<typename Descriptor>
+    Descriptor toDescriptor() const
+    {
+        Descriptor descriptor;
+        for (std::size_t cell = 0; cell < Grid::cellCount; ++cell)
+        {
+            for (Integer value = 1; value <= Grid::maxValue; ++value)
+            {
+                std::size_t const bit = Descriptor::bitIndex(cell, value);
+                descriptor.possibilities().set(bit, (m_candidates[cell] & valueBit(value)) != 0);
+                descriptor.missingValuesMask().set(bit, m_values[cell] == 0);
+            }
+        }
+
+        return descriptor;
+    }
+
+    operator Grid() const
+    {
+        Grid grid;
+        std::copy(m_values.begin(), m_values.end(), grid.begin());
+        return grid;
+    }
+
+    Candidates candidates(std::size_t cell) const
+    {
+        return m_candidates[cell];
+    }
+
+    // Contiguous per-cell candidate words, indexed by cell
+    std::array<Candidates, Grid::cellCount> const& candidates() const
+    {
+        return m_candidates;
+    }
+
+    // Removes the given candidates from the cell, returns whether any was actually removed
+    bool eliminate(std::size_t cell, Candidates toRemove)
+    {
+        Candidates const remaining = m_candidates[cell] & static_cast<Candidates>(~toRemove);
+        bool const changed = remaining != m_candidates[cell];
+        m_candidates[cell] = remaining;
+        return changed;
+    }
+
+    // 0 while the cell is unsolved
+    Integer value(std::size_t cell) const
+    {
+        return m_values[cell];
+    }
+
+    Candidates placedValues(std::size_t house) const
+    {
+        return m_placedValues[house];
+    }
+
+    bool isFilled() const
+    {
+        return m_missingCount == 0;
+    }
+
+    // Places value in the cell and removes it from the candidates of the cell's peers
+    void setValue(std::size_t cell, Integer value)
+    {
+        Candidates const bit = valueBit(value);
+        Candidates const mask = static_cast<Candidates>(~bit);
+
+        if (m_values[cell] == 0)
+        {
+            --m_missingCount;
+        }
+
+        m_values[cell] = value;
+        m_candidates[cell] = bit;
+
+        for (auto peer : Topology::cellPeers[cell])
+        {
+            m_candidates[peer] &= mask;
+        }
+
+        for (auto house : Topology::cellHouses[cell])
+        {
+            m_placedValues[house] |= bit;
+        }
+    }
+
+private:
+    std::array<Candidates, Grid::cellCount> m_candidates{};
+    std::array<Integer, Grid::cellCount> m_values{};
+    std::array<Candidates, Topology::houseCount> m_placedValues{};
+    std::size_t m_missingCount = Grid::cellCount;
+};
@@ -0,0 +1,250 @@
+// Copyright 2022 DrSinIsIn (axel.gaillard.dev@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Exact cover solver (Knuth's Algorithm X with dancing links): finds sets of rows covering every column exactly once.
+// Nodes live in one contiguous pool and link each other by index, so that building the matrix does a single
+// allocation when the node count is known up front, and covering a column only rewrites a few indices.
+class DancingLinks
+{
+public:
+    // nodeCapacity is the expected number of ones in the matrix, the pool grows past it if needed
+    explicit DancingLinks(std::size_t columnCount, std::size_t nodeCapacity = 0)
+        : m_columnSizes(columnCount)
+    {
+        m_nodes.reserve(1 + columnCount + nodeCapacity);
+
+        // Root, then one header per column, in a circular list
+        for (std::size_t i = 0; i <= columnCount; ++i)
+        {
+            auto const index = static_cast<Index>(i);
+            m_nodes.push_back(Node{ .left = (i == 0) ? static_cast<Index>(columnCount) : index - 1
+                                  , .right = (i == columnCount) ? Index{ 0 } : index + 1
+                                  , .up = index
+                                  , .down = index
+                                  , .column = index
+                                  , .row = noRow });
+        }
+    }
+
+    std::size_t columnCount() const noexcept
+    {
+        return m_columnSizes.size();
+    }
+
+    std::size_t rowCount() const noexcept
+    {
+        return m_rowFirstNodes.size();
+    }
+
+    // Adds a row with ones in the given distinct columns, and returns its index
+    std::size_t addRow(std::span<std::size_t const> columns)
+    {
+        auto const row = static_cast<Index>(m_rowFirstNodes.size());
+        auto const first = static_cast<Index>(m_nodes.size());
+        m_rowFirstNodes.push_back(first);
+
+        for (std::size_t i = 0; i < columns.size(); ++i)
+        {
+            auto const index = static_cast<Index>(m_nodes.size());
+            auto const header = static_cast<Index>(columns[i] + 1);
+
+            // Last in the column, and in the row's circular list
+            m_nodes.push_back(Node{ .left = (i == 0) ? index : index - 1
+                                  , .right = first
+                                  , .up = m_nodes[header].up
+                                  , .down = header
+                                  , .column = header
+                                  , .row = row });
+            m_nodes[m_nodes[header].up].down = index;
+            m_nodes[header].up = index;
+            m_nodes[index - ((i == 0) ? 0 : 1)].right = index;
+            m_nodes[first].left = index;
+            ++m_columnSizes[columns[i]];
+        }
+
+        return row;
+    }
+
+    // Puts the row in every solution, as done for the givens of a puzzle. Fails when the row conflicts with a row
+    // selected before, in which case there is no solution anymore. Selections can't be undone.
+    bool select(std::size_t row)
+    {
+        Index const first = m_rowFirstNodes[row];
+        Index node = first;
+        do
+        {
+            if (!isLinked(node))
+            {
+                m_hasConflict = true;
+                return false;
+            }
+            node = m_nodes[node].right;
+        } while (node != first);
+
+        do
+        {
+            cover(m_nodes[node].column);
+            node = m_nodes[node].right;
+        } while (node != first);
+
+        m_selectedRows.push_back(static_cast<Index>(row));
+        return true;
+    }
+
+    // Calls onSolution(std::span<std::size_t const> rows) with the rows of each exact cover, selected ones included,
+    // until limit solutions have been found or onSolution returns false. Returns the number of solutions found.
+    // The matrix is left as it was, ready for another search.
+    template<typename OnSolution>
+    std::size_t search(std::size_t limit, OnSolution&& onSolution)
+    {
+        if (m_hasConflict || (limit == 0))
+        {
+            return 0;
+        }
+
+        m_partialSolution.assign(m_selectedRows.begin(), m_selectedRows.end());
+        m_solutionCount = 0;
+        m_limit = limit;
+        m_isStopped = false;
+        searchFrom(onSolution);
+        return m_solutionCount;
+    }
+
+    std::size_t countSolutions(std::size_t limit)
+    {
+        return search(limit, [](std::span<std::size_t const>) { return true; });
+    }
+
+private:
+    using Index = std::uint32_t;
+
+    static constexpr Index noRow = ~Index{};
+
+    struct Node
+    {
+        Index left;
+        Index right;
+        Index up;
+        Index down;
+        Index column; // Column header of the node, headers being nodes 1 to columnCount
+        Index row;
+    };
+
+    std::vector<Node> m_nodes;
+    std::vector<std::size_t> m_columnSizes;
+    std::vector<Index> m_rowFirstNodes;
+    std::vector<Index> m_selectedRows;
+    std::vector<std::size_t> m_partialSolution;
+    std::size_t m_solutionCount = 0;
+    std::size_t m_limit = 0;
+    bool m_hasConflict = false;
+    bool m_isStopped = false;
+
+    // Neither the node's column nor the node itself have been removed by a cover
+    bool isLinked(Index node) const
+    {
+        Index const header = m_nodes[node].column;
+        return (m_nodes[m_nodes[header].left].right == header) && (m_nodes[m_nodes[node].up].down == node);
+    }
+
+    void cover(Index header)
+    {
+        m_nodes[m_nodes[header].right].left = m_nodes[header].left;
+        m_nodes[m_nodes[header].left].right = m_nodes[header].right;
+
+        for (Index i = m_nodes[header].down; i != header; i = m_nodes[i].down)
+        {
+            for (Index j = m_nodes[i].right; j != i; j = m_nodes[j].right)
+            {
+                m_nodes[m_nodes[j].down].up = m_nodes[j].up;
+                m_nodes[m_nodes[j].up].down = m_nodes[j].down;
+                --m_columnSizes[m_nodes[j].column - 1];
+            }
+        }
+    }
+
+    // Exact reverse of cover
+    void uncover(Index header)
+    {
+        for (Index i = m_nodes[header].up; i != header; i = m_nodes[i].up)
+        {
+            for (Index j = m_nodes[i].left; j != i; j = m_nodes[j].left)
+            {
+                ++m_columnSizes[m_nodes[j].column - 1];
+                m_nodes[m_nodes[j].down].up = j;
+                m_nodes[m_nodes[j].up].down = j;
+            }
+        }
+
+        m_nodes[m_nodes[header].right].left = header;
+        m_nodes[m_nodes[header].left].right = header;
+    }
+
+    // Column with the fewest rows left, the root when every column is covered
+    Index chooseColumn() const
+    {
+        Index best = 0;
+        std::size_t bestSize = ~std::size_t{};
+        for (Index header = m_nodes[0].right; header != 0; header = m_nodes[header].right)
+        {
+            std::size_t const size = m_columnSizes[header - 1];
+            if (size < bestSize)
+            {
+                best = header;
+                bestSize = size;
+                if (size <= 1)
+                {
+                    break;
+                }
+            }
+        }
+
+        return best;
+    }
+
+    template<typename OnSolution>
+    void searchFrom(OnSolution& onSolution)
+    {
+        Index const header = chooseColumn();
+        if (header == 0)
+        {
+            ++m_solutionCount;
+            m_isStopped = !onSolution(std::span<std::size_t const>{ m_partialSolution })
+                       || (m_solutionCount >= m_limit);
+            return;
+        }
+
+        if (m_columnSizes[header - 1] == 0)
+        {
+            return;
+        }
+
+        cover(header);
+        for (Index i = m_nodes[header].down; (i != header) && !m_isStopped; i = m_nodes[i].down)
+        {
+            m_partialSolution.push_back(m_nodes[i].row);
+            for (Index j = m_nodes[i].right; j != i; j = m_nodes[j].right)
+            {
+                cover(m_nodes[j].column);
+            }
+
+            searchFrom(onSolution);
+
+            for (Index j = m_nodes[i].left; j != i; j = m_nodes[j].left)
+            {
+                uncover(m_nodes[j].column);
+            }
+            m_partialSolution.pop_back();
+        }
+        uncover(header);
+    }
+};
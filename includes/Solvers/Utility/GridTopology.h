@@ -0,0 +1,146 @@
+// Copyright 2022 DrSinIsIn (axel.gaillard.dev@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "Sudoku.h"
+
+// Cell/house incidence of a grid, computed at compile time.
+// Houses are numbered rows first, then columns, then boxes: [0, n) rows, [n, 2n) columns, [2n, 3n) boxes.
+template<typename Grid>
+struct GridTopology
+{
+    using CellIndex = typename details::FirstAccomodating<Grid::cellCount
+                                                        , std::uint8_t
+                                                        , std::uint16_t
+                                                        , std::uint32_t
+                                                        , std::uint64_t>::type;
+    using HouseIndex = typename details::FirstAccomodating<3 * Grid::maxValue
+                                                         , std::uint8_t
+                                                         , std::uint16_t
+                                                         , std::uint32_t
+                                                         , std::uint64_t>::type;
+
+    // One bit per cell of a house, in the order of houseCells
+    using HousePositions = typename details::FirstAccomodating<((std::uintmax_t{ 1 } << (Grid::maxValue - 1)) * 2) - 1
+                                                             , std::uint8_t
+                                                             , std::uint16_t
+                                                             , std::uint32_t
+                                                             , std::uint64_t>::type;
+
+    static constexpr std::size_t houseSize = Grid::maxValue;
+    static constexpr std::size_t houseCount = Grid::rowCount + Grid::columnCount + Grid::boxCount;
+    static constexpr std::size_t housesPerCell = 3;
+
+    // Every other cell sharing a house with a given cell
+    static constexpr std::size_t peerCount = (Grid::rowCount - 1)
+                                           + (Grid::columnCount - 1)
+                                           + ((Grid::boxWidth - 1) * (Grid::boxHeight - 1));
+
+    static constexpr std::size_t rowHouse(std::size_t y) noexcept
+    {
+        return y;
+    }
+
+    static constexpr std::size_t columnHouse(std::size_t x) noexcept
+    {
+        return Grid::rowCount + x;
+    }
+
+    static constexpr std::size_t boxHouse(std::size_t index) noexcept
+    {
+        return Grid::rowCount + Grid::columnCount + index;
+    }
+
+    // Absolute cell index of the localIndex-th cell of a house
+    static constexpr std::size_t houseCell(std::size_t house, std::size_t localIndex) noexcept
+    {
+        if (house < Grid::rowCount)
+        {
+            return Grid::coordinatesToCell(localIndex, house);
+        }
+
+        if (house < (Grid::rowCount + Grid::columnCount))
+        {
+            return Grid::coordinatesToCell(house - Grid::rowCount, localIndex);
+        }
+
+        auto const [boxX, boxY] = Grid::cellToCoordinates(
+            Grid::boxIndexToTopLeftCell(house - Grid::rowCount - Grid::columnCount));
+        return Grid::coordinatesToCell(boxX + (localIndex % Grid::boxWidth), boxY + (localIndex / Grid::boxWidth));
+    }
+
+    static constexpr std::array<std::array<CellIndex, houseSize>, houseCount> houseCells = []
+    {
+        std::array<std::array<CellIndex, houseSize>, houseCount> result{};
+        for (std::size_t house = 0; house < houseCount; ++house)
+        {
+            for (std::size_t i = 0; i < houseSize; ++i)
+            {
+                result[house][i] = static_cast<CellIndex>(houseCell(house, i));
+            }
+        }
+
+        return result;
+    }();
+
+    // Row, column and box of each cell, in that order
+    static constexpr std::array<std::array<HouseIndex, housesPerCell>, Grid::cellCount> cellHouses = []
+    {
+        std::array<std::array<HouseIndex, housesPerCell>, Grid::cellCount> result{};
+        for (std::size_t cell = 0; cell < Grid::cellCount; ++cell)
+        {
+            result[cell] = { static_cast<HouseIndex>(rowHouse(Grid::cellToY(cell)))
+                           , static_cast<HouseIndex>(columnHouse(Grid::cellToX(cell)))
+                           , static_cast<HouseIndex>(boxHouse(Grid::cellToBoxIndex(cell))) };
+        }
+
+        return result;
+    }();
+
+    // Peers of each cell: row peers, then column peers, then box peers sharing neither
+    static constexpr std::array<std::array<CellIndex, peerCount>, Grid::cellCount> cellPeers = []
+    {
+        std::array<std::array<CellIndex, peerCount>, Grid::cellCount> result{};
+        for (std::size_t cell = 0; cell < Grid::cellCount; ++cell)
+        {
+            auto const x = Grid::cellToX(cell);
+            auto const y = Grid::cellToY(cell);
+            auto const [rowHouseIndex, columnHouseIndex, boxHouseIndex] = cellHouses[cell];
+
+            std::size_t count = 0;
+            for (auto other : houseCells[rowHouseIndex])
+            {
+                if (other != cell)
+                {
+                    result[cell][count++] = other;
+                }
+            }
+
+            for (auto other : houseCells[columnHouseIndex])
+            {
+                if (other != cell)
+                {
+                    result[cell][count++] = other;
+                }
+            }
+
+            for (auto other : houseCells[boxHouseIndex])
+            {
+                if ((Grid::cellToX(other) != x) && (Grid::cellToY(other) != y))
+                {
+                    result[cell][count++] = other;
+                }
+            }
+        }
+
+        return result;
+    }();
+};
@@ -7,33 +7,159 @@
 
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <concepts>
 #include <cstddef>
+#include <iterator>
+#include <numeric>
+#include <span>
 
 namespace MathUtils
 {
+    // Lexicographically next subsetSize-combination of [0, setSize), back to the first one after the last one
     template<std::size_t setSize, std::unsigned_integral Element, std::size_t subsetSize>
         requires (subsetSize <= setSize)
     constexpr bool nextCombination(std::array<Element, subsetSize>& inOutCombination)
     {
-        std::array<bool, setSize> permutable{};
-        for (auto index : inOutCombination)
+        for (std::size_t i = subsetSize; i-- > 0;)
         {
-            permutable[index] = true;
+            // Rightmost element that can still move right, the following ones come right after it
+            if (inOutCombination[i] < (setSize - subsetSize + i))
+            {
+                ++inOutCombination[i];
+                for (std::size_t j = i + 1; j < subsetSize; ++j)
+                {
+                    inOutCombination[j] = static_cast<Element>(inOutCombination[j - 1] + 1);
+                }
+                return true;
+            }
         }
 
-        bool const isNewCombinationLexicographicallyNext
-            = std::prev_permutation(permutable.begin(), permutable.end());
+        std::iota(inOutCombination.begin(), inOutCombination.end(), Element{});
+        return false;
+    }
+
+    // Combinations of subsetSize masks among a span whose union has at most maxUnionCount bits. Combinations are
+    // extended one mask at a time and dropped as soon as the union is too large, since adding masks never shrinks
+    // it, so the whole search costs far less than the C(n, k) combinations when most of them go over the bound.
+    // Masks may change while iterating: later combinations see the new values.
+    template<std::size_t subsetSize, std::unsigned_integral Mask>
+        requires (subsetSize > 0)
+    class BoundedUnionCombinations
+    {
+    public:
+        struct Combination
+        {
+            std::array<std::size_t, subsetSize> indices{}; // Increasing indices of the masks in the span
+            Mask unionMask{};
+        };
 
-        auto outIt = inOutCombination.begin();
-        for (Element element{}; outIt != inOutCombination.end(); ++element)
+        class Iterator
         {
-            if (permutable[element])
+        public:
+            using value_type = Combination;
+            using difference_type = std::ptrdiff_t;
+
+            Iterator() = default;
+
+            constexpr Iterator(std::span<Mask const> masks, std::size_t maxUnionCount) noexcept
+                : m_masks{ masks }
+                , m_maxUnionCount{ maxUnionCount }
+            {
+                search(0);
+            }
+
+            constexpr Combination const& operator*() const noexcept
+            {
+                return m_combination;
+            }
+
+            constexpr Combination const* operator->() const noexcept
+            {
+                return &m_combination;
+            }
+
+            constexpr Iterator& operator++() noexcept
+            {
+                search(m_combination.indices[m_depth] + 1);
+                return *this;
+            }
+
+            constexpr Iterator operator++(int) noexcept
             {
-                *(outIt++) = element;
+                Iterator previous = *this;
+                ++*this;
+                return previous;
             }
+
+            constexpr bool operator==(std::default_sentinel_t) const noexcept
+            {
+                return m_isDone;
+            }
+
+        private:
+            // Depth-first, trying the mask at index next for position m_depth of the combination
+            constexpr void search(std::size_t next) noexcept
+            {
+                while (true)
+                {
+                    if ((next + (subsetSize - m_depth)) > m_masks.size())
+                    {
+                        if (m_depth == 0)
+                        {
+                            m_isDone = true;
+                            return;
+                        }
+
+                        --m_depth;
+                        next = m_combination.indices[m_depth] + 1;
+                        continue;
+                    }
+
+                    Mask const unionMask = m_unions[m_depth] | m_masks[next];
+                    if (static_cast<std::size_t>(std::popcount(unionMask)) > m_maxUnionCount)
+                    {
+                        ++next;
+                        continue;
+                    }
+
+                    m_combination.indices[m_depth] = next;
+                    if ((m_depth + 1) == subsetSize)
+                    {
+                        m_combination.unionMask = unionMask;
+                        return;
+                    }
+
+                    m_unions[++m_depth] = unionMask;
+                    next = m_combination.indices[m_depth - 1] + 1;
+                }
+            }
+
+            std::span<Mask const> m_masks;
+            std::size_t m_maxUnionCount{};
+            std::array<Mask, subsetSize> m_unions{}; // Union of the masks before each position
+            Combination m_combination{};
+            std::size_t m_depth = 0;
+            bool m_isDone = false;
+        };
+
+        constexpr BoundedUnionCombinations(std::span<Mask const> masks, std::size_t maxUnionCount) noexcept
+            : m_masks{ masks }
+            , m_maxUnionCount{ maxUnionCount }
+        {}
+
+        constexpr Iterator begin() const noexcept
+        {
+            return Iterator{ m_masks, m_maxUnionCount };
         }
 
-        return isNewCombinationLexicographicallyNext;
-    }
+        constexpr std::default_sentinel_t end() const noexcept
+        {
+            return {};
+        }
+
+    private:
+        std::span<Mask const> m_masks;
+        std::size_t m_maxUnionCount{};
+    };
 }
@@ -7,59 +7,188 @@
 
 #include <bit>
 #include <climits>
+#include <concepts>
 #include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
 
+namespace details
+{
+    // Bitsets exposing their storage words, such as StaticBitset
+    template<typename Bitset>
+    concept WordIndexedBitset = requires(Bitset const& bitset)
+    {
+        { Bitset::wordCount } -> std::convertible_to<std::size_t>;
+        { bitset.word(0) } -> std::unsigned_integral;
+    };
+
+    // libstdc++'s std::bitset extension
+    template<typename Bitset>
+    concept FindNextBitset = requires(Bitset const& bitset)
+    {
+        { bitset._Find_first() } -> std::convertible_to<std::size_t>;
+        { bitset._Find_next(0) } -> std::convertible_to<std::size_t>;
+    };
+
+    // Word the iterator keeps, unused by bitsets not exposing theirs
+    template<typename Bitset>
+    struct BitsetWord
+    {
+        using type = unsigned;
+    };
+
+    template<WordIndexedBitset Bitset>
+    struct BitsetWord<Bitset>
+    {
+        using type = std::remove_cvref_t<decltype(std::declval<Bitset const&>().word(0))>;
+    };
+} // namespace details
+
+// Indices of the set bits of a bitset, in increasing order. The iterator only refers to the bitset, which must
+// outlive it: prefer setBits below, which also keeps temporaries alive. A default constructed iterator is the end.
+// Bitsets exposing their words are walked one word at a time, the current word losing its lowest bit at each step.
 template<typename Bitset>
 class SetBitIterator
 {
 public:
-    explicit SetBitIterator(Bitset const& b = Bitset{})
-        : m_remaining{ b }
+    using value_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    SetBitIterator() = default;
+
+    explicit SetBitIterator(Bitset const& bitset)
+        : m_bitset{ &bitset }
     {
-        goToNext();
+        if constexpr (details::WordIndexedBitset<Bitset>)
+        {
+            if constexpr (Bitset::wordCount > 0)
+            {
+                m_word = bitset.word(0);
+            }
+            goToNextWord();
+        }
+        else if constexpr (details::FindNextBitset<Bitset>)
+        {
+            m_index = bitset._Find_first();
+        }
+        else
+        {
+            m_index = 0;
+            goToNextBit();
+        }
     }
 
-    constexpr bool operator==(SetBitIterator const&) const = default;
+    // The iterator would outlive a temporary: use setBits instead
+    explicit SetBitIterator(Bitset&&) = delete;
 
-    auto& operator++()
+    bool operator==(SetBitIterator const& other) const
     {
-        m_index += 1;
-        m_remaining >>= 1;
-        goToNext();
+        return m_index == other.m_index;
+    }
+
+    bool operator==(std::default_sentinel_t) const
+    {
+        return m_index == bitCount;
+    }
+
+    SetBitIterator& operator++()
+    {
+        if constexpr (details::WordIndexedBitset<Bitset>)
+        {
+            m_word &= m_word - 1;
+            goToNextWord();
+        }
+        else if constexpr (details::FindNextBitset<Bitset>)
+        {
+            m_index = m_bitset->_Find_next(m_index);
+        }
+        else
+        {
+            ++m_index;
+            goToNextBit();
+        }
+
         return *this;
     }
 
+    SetBitIterator operator++(int)
+    {
+        SetBitIterator previous = *this;
+        ++*this;
+        return previous;
+    }
+
     std::size_t operator*() const
     {
         return m_index;
     }
 
 private:
-    Bitset m_remaining;
-    std::size_t m_index = {};
+    static constexpr std::size_t bitCount = Bitset{}.size();
+
+    using Word = typename details::BitsetWord<Bitset>::type;
 
-    void goToNext()
+    static constexpr std::size_t wordWidth = sizeof(Word) * CHAR_BIT;
+
+    Bitset const* m_bitset = nullptr;
+    std::size_t m_index = bitCount;
+    std::size_t m_wordIndex = 0;
+    Word m_word{};
+
+    // Skips the empty words, m_word being what is left of word m_wordIndex
+    void goToNextWord()
     {
-        if (m_remaining.none())
+        while (m_word == 0)
         {
-            m_index = m_remaining.size();
-            return;
+            if (++m_wordIndex >= Bitset::wordCount)
+            {
+                m_index = bitCount;
+                return;
+            }
+            m_word = m_bitset->word(m_wordIndex);
         }
 
-        constexpr auto ullWidth = sizeof(unsigned long long) * CHAR_BIT;
-        constexpr Bitset ullMask = ~0ull;
+        m_index = (m_wordIndex * wordWidth) + static_cast<std::size_t>(std::countr_zero(m_word));
+    }
 
-        Bitset nextULLBitset;
-        while ((nextULLBitset = (m_remaining & ullMask)).none())
+    void goToNextBit()
+    {
+        while ((m_index < bitCount) && !m_bitset->test(m_index))
         {
-            m_index += ullWidth;
-            m_remaining >>= ullWidth;
+            ++m_index;
         }
+    }
+};
 
-        auto const asULL = nextULLBitset.to_ullong();
-        auto const countZeros = std::countr_zero(asULL);
+// Range of the indices of the set bits, for (std::size_t index : setBits(bitset)). Temporaries are moved into the
+// range, which range-for keeps alive for the whole loop; other bitsets are referred to.
+template<typename Bitset>
+class SetBits
+{
+public:
+    using Value = std::remove_cvref_t<Bitset>;
+
+    explicit SetBits(Bitset&& bitset)
+        : m_bitset{ std::forward<Bitset>(bitset) }
+    {}
 
-        m_index += countZeros;
-        m_remaining >>= countZeros;
+    SetBitIterator<Value> begin() const
+    {
+        return SetBitIterator<Value>{ m_bitset };
     }
+
+    std::default_sentinel_t end() const
+    {
+        return {};
+    }
+
+private:
+    Bitset m_bitset;
 };
+
+template<typename Bitset>
+SetBits<Bitset> setBits(Bitset&& bitset)
+{
+    return SetBits<Bitset>{ std::forward<Bitset>(bitset) };
+}
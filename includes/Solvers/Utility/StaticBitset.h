@@ -0,0 +1,556 @@
+// Copyright 2022 DrSinIsIn (axel.gaillard.dev@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+namespace details
+{
+    // Word-wise kernels shared by StaticBitset. Word counts of vectorized calls are always a multiple of the
+    // vector width and storage is aligned accordingly, so that no tail loop is needed.
+    namespace BitsetKernels
+    {
+        using Word = std::uint64_t;
+
+        inline constexpr std::size_t vectorWordCount = 4;
+
+        template<typename Operation>
+        constexpr void apply(Word* lhs, Word const* rhs, std::size_t wordCount, Operation operation) noexcept
+        {
+            for (std::size_t i = 0; i < wordCount; ++i)
+            {
+                lhs[i] = operation(lhs[i], rhs[i]);
+            }
+        }
+
+        constexpr void bitwiseAnd(Word* lhs, Word const* rhs, std::size_t wordCount) noexcept
+        {
+            if (!std::is_constant_evaluated() && ((wordCount % vectorWordCount) == 0))
+            {
+#if defined(__AVX2__)
+                for (std::size_t i = 0; i < wordCount; i += 4)
+                {
+                    auto* const out = reinterpret_cast<__m256i*>(lhs + i);
+                    auto const in = _mm256_load_si256(reinterpret_cast<__m256i const*>(rhs + i));
+                    _mm256_store_si256(out, _mm256_and_si256(_mm256_load_si256(out), in));
+                }
+                return;
+#elif defined(__SSE2__) || defined(_M_X64)
+                for (std::size_t i = 0; i < wordCount; i += 2)
+                {
+                    auto* const out = reinterpret_cast<__m128i*>(lhs + i);
+                    auto const in = _mm_load_si128(reinterpret_cast<__m128i const*>(rhs + i));
+                    _mm_store_si128(out, _mm_and_si128(_mm_load_si128(out), in));
+                }
+                return;
+#endif
+            }
+
+            apply(lhs, rhs, wordCount, [](Word a, Word b) { return a & b; });
+        }
+
+        constexpr void bitwiseOr(Word* lhs, Word const* rhs, std::size_t wordCount) noexcept
+        {
+            if (!std::is_constant_evaluated() && ((wordCount % vectorWordCount) == 0))
+            {
+#if defined(__AVX2__)
+                for (std::size_t i = 0; i < wordCount; i += 4)
+                {
+                    auto* const out = reinterpret_cast<__m256i*>(lhs + i);
+                    auto const in = _mm256_load_si256(reinterpret_cast<__m256i const*>(rhs + i));
+                    _mm256_store_si256(out, _mm256_or_si256(_mm256_load_si256(out), in));
+                }
+                return;
+#elif defined(__SSE2__) || defined(_M_X64)
+                for (std::size_t i = 0; i < wordCount; i += 2)
+                {
+                    auto* const out = reinterpret_cast<__m128i*>(lhs + i);
+                    auto const in = _mm_load_si128(reinterpret_cast<__m128i const*>(rhs + i));
+                    _mm_store_si128(out, _mm_or_si128(_mm_load_si128(out), in));
+                }
+                return;
+#endif
+            }
+
+            apply(lhs, rhs, wordCount, [](Word a, Word b) { return a | b; });
+        }
+
+        constexpr void bitwiseXor(Word* lhs, Word const* rhs, std::size_t wordCount) noexcept
+        {
+            if (!std::is_constant_evaluated() && ((wordCount % vectorWordCount) == 0))
+            {
+#if defined(__AVX2__)
+                for (std::size_t i = 0; i < wordCount; i += 4)
+                {
+                    auto* const out = reinterpret_cast<__m256i*>(lhs + i);
+                    auto const in = _mm256_load_si256(reinterpret_cast<__m256i const*>(rhs + i));
+                    _mm256_store_si256(out, _mm256_xor_si256(_mm256_load_si256(out), in));
+                }
+                return;
+#elif defined(__SSE2__) || defined(_M_X64)
+                for (std::size_t i = 0; i < wordCount; i += 2)
+                {
+                    auto* const out = reinterpret_cast<__m128i*>(lhs + i);
+                    auto const in = _mm_load_si128(reinterpret_cast<__m128i const*>(rhs + i));
+                    _mm_store_si128(out, _mm_xor_si128(_mm_load_si128(out), in));
+                }
+                return;
+#endif
+            }
+
+            apply(lhs, rhs, wordCount, [](Word a, Word b) { return a ^ b; });
+        }
+
+        // lhs &= ~rhs
+        constexpr void bitwiseAndNot(Word* lhs, Word const* rhs, std::size_t wordCount) noexcept
+        {
+            if (!std::is_constant_evaluated() && ((wordCount % vectorWordCount) == 0))
+            {
+#if defined(__AVX2__)
+                for (std::size_t i = 0; i < wordCount; i += 4)
+                {
+                    auto* const out = reinterpret_cast<__m256i*>(lhs + i);
+                    auto const in = _mm256_load_si256(reinterpret_cast<__m256i const*>(rhs + i));
+                    _mm256_store_si256(out, _mm256_andnot_si256(in, _mm256_load_si256(out)));
+                }
+                return;
+#elif defined(__SSE2__) || defined(_M_X64)
+                for (std::size_t i = 0; i < wordCount; i += 2)
+                {
+                    auto* const out = reinterpret_cast<__m128i*>(lhs + i);
+                    auto const in = _mm_load_si128(reinterpret_cast<__m128i const*>(rhs + i));
+                    _mm_store_si128(out, _mm_andnot_si128(in, _mm_load_si128(out)));
+                }
+                return;
+#endif
+            }
+
+            apply(lhs, rhs, wordCount, [](Word a, Word b) { return a & ~b; });
+        }
+
+        constexpr bool none(Word const* words, std::size_t wordCount) noexcept
+        {
+            if (!std::is_constant_evaluated() && ((wordCount % vectorWordCount) == 0))
+            {
+#if defined(__AVX2__)
+                __m256i accumulator = _mm256_setzero_si256();
+                for (std::size_t i = 0; i < wordCount; i += 4)
+                {
+                    auto const in = _mm256_load_si256(reinterpret_cast<__m256i const*>(words + i));
+                    accumulator = _mm256_or_si256(accumulator, in);
+                }
+                return _mm256_testz_si256(accumulator, accumulator) != 0;
+#elif defined(__SSE2__) || defined(_M_X64)
+                __m128i accumulator = _mm_setzero_si128();
+                for (std::size_t i = 0; i < wordCount; i += 2)
+                {
+                    auto const in = _mm_load_si128(reinterpret_cast<__m128i const*>(words + i));
+                    accumulator = _mm_or_si128(accumulator, in);
+                }
+                return _mm_movemask_epi8(_mm_cmpeq_epi8(accumulator, _mm_setzero_si128())) == 0xFFFF;
+#endif
+            }
+
+            Word accumulator = 0;
+            for (std::size_t i = 0; i < wordCount; ++i)
+            {
+                accumulator |= words[i];
+            }
+            return accumulator == 0;
+        }
+
+        constexpr bool equal(Word const* lhs, Word const* rhs, std::size_t wordCount) noexcept
+        {
+            if (!std::is_constant_evaluated() && ((wordCount % vectorWordCount) == 0))
+            {
+#if defined(__AVX2__)
+                __m256i accumulator = _mm256_setzero_si256();
+                for (std::size_t i = 0; i < wordCount; i += 4)
+                {
+                    auto const a = _mm256_load_si256(reinterpret_cast<__m256i const*>(lhs + i));
+                    auto const b = _mm256_load_si256(reinterpret_cast<__m256i const*>(rhs + i));
+                    accumulator = _mm256_or_si256(accumulator, _mm256_xor_si256(a, b));
+                }
+                return _mm256_testz_si256(accumulator, accumulator) != 0;
+#elif defined(__SSE2__) || defined(_M_X64)
+                __m128i accumulator = _mm_setzero_si128();
+                for (std::size_t i = 0; i < wordCount; i += 2)
+                {
+                    auto const a = _mm_load_si128(reinterpret_cast<__m128i const*>(lhs + i));
+                    auto const b = _mm_load_si128(reinterpret_cast<__m128i const*>(rhs + i));
+                    accumulator = _mm_or_si128(accumulator, _mm_xor_si128(a, b));
+                }
+                return _mm_movemask_epi8(_mm_cmpeq_epi8(accumulator, _mm_setzero_si128())) == 0xFFFF;
+#endif
+            }
+
+            Word accumulator = 0;
+            for (std::size_t i = 0; i < wordCount; ++i)
+            {
+                accumulator |= lhs[i] ^ rhs[i];
+            }
+            return accumulator == 0;
+        }
+
+        constexpr std::size_t count(Word const* words, std::size_t wordCount) noexcept
+        {
+            std::size_t result = 0;
+            for (std::size_t i = 0; i < wordCount; ++i)
+            {
+                result += static_cast<std::size_t>(std::popcount(words[i]));
+            }
+
+            return result;
+        }
+    } // namespace BitsetKernels
+} // namespace details
+
+// Fixed-size bitset stored as an aligned array of 64-bit words, with the interface of std::bitset used by the
+// solvers. Storage is padded to a whole number of vector registers; bits past bitCount are always zero.
+template<std::size_t bitCount>
+class StaticBitset
+{
+public:
+    using Word = details::BitsetKernels::Word;
+
+    static constexpr std::size_t wordWidth = sizeof(Word) * CHAR_BIT;
+    static constexpr std::size_t wordCount = (bitCount + wordWidth - 1) / wordWidth;
+    static constexpr std::size_t storageWordCount = []
+    {
+        constexpr auto vectorWordCount = details::BitsetKernels::vectorWordCount;
+        if (wordCount < vectorWordCount)
+        {
+            return wordCount;
+        }
+
+        return ((wordCount + vectorWordCount - 1) / vectorWordCount) * vectorWordCount;
+    }();
+
+    constexpr StaticBitset() noexcept = default;
+
+    constexpr StaticBitset(unsigned long long value) noexcept
+    {
+        if constexpr (wordCount > 0)
+        {
+            m_words[0] = value;
+            clearUnusedBits();
+        }
+    }
+
+    static constexpr std::size_t size() noexcept
+    {
+        return bitCount;
+    }
+
+    constexpr bool test(std::size_t index) const noexcept
+    {
+        return ((m_words[index / wordWidth] >> (index % wordWidth)) & 1) != 0;
+    }
+
+    constexpr bool operator[](std::size_t index) const noexcept
+    {
+        return test(index);
+    }
+
+    constexpr StaticBitset& set() noexcept
+    {
+        std::fill_n(m_words.begin(), wordCount, ~Word{});
+        clearUnusedBits();
+        return *this;
+    }
+
+    constexpr StaticBitset& set(std::size_t index, bool value = true) noexcept
+    {
+        Word const bit = Word{ 1 } << (index % wordWidth);
+        Word& word = m_words[index / wordWidth];
+        word = value ? (word | bit) : (word & ~bit);
+        return *this;
+    }
+
+    constexpr StaticBitset& reset() noexcept
+    {
+        m_words = {};
+        return *this;
+    }
+
+    constexpr StaticBitset& reset(std::size_t index) noexcept
+    {
+        return set(index, false);
+    }
+
+    constexpr StaticBitset& flip() noexcept
+    {
+        for (std::size_t i = 0; i < wordCount; ++i)
+        {
+            m_words[i] = ~m_words[i];
+        }
+
+        clearUnusedBits();
+        return *this;
+    }
+
+    constexpr std::size_t count() const noexcept
+    {
+        return details::BitsetKernels::count(m_words.data(), storageWordCount);
+    }
+
+    constexpr bool none() const noexcept
+    {
+        return details::BitsetKernels::none(m_words.data(), storageWordCount);
+    }
+
+    constexpr bool any() const noexcept
+    {
+        return !none();
+    }
+
+    constexpr bool all() const noexcept
+    {
+        return *this == StaticBitset{}.set();
+    }
+
+    // Index of the first set bit, or size() if there is none
+    constexpr std::size_t findFirst() const noexcept
+    {
+        return findFromWord(0);
+    }
+
+    // Index of the first set bit strictly after index, or size() if there is none
+    constexpr std::size_t findNext(std::size_t index) const noexcept
+    {
+        ++index;
+        if (index >= bitCount)
+        {
+            return bitCount;
+        }
+
+        std::size_t const wordIndex = index / wordWidth;
+        Word const word = m_words[wordIndex] & (~Word{} << (index % wordWidth));
+        if (word != 0)
+        {
+            return (wordIndex * wordWidth) + static_cast<std::size_t>(std::countr_zero(word));
+        }
+
+        return findFromWord(wordIndex + 1);
+    }
+
+    // Copy of the bits in [first, first + length), every other bit cleared. Only the words of the range are read.
+    constexpr StaticBitset keepRange(std::size_t first, std::size_t length) const noexcept
+    {
+        StaticBitset result{};
+        if (length == 0)
+        {
+            return result;
+        }
+
+        std::size_t const last = first + length - 1;
+        std::size_t const firstWord = first / wordWidth;
+        std::size_t const lastWord = last / wordWidth;
+        for (std::size_t i = firstWord; i <= lastWord; ++i)
+        {
+            result.m_words[i] = m_words[i];
+        }
+
+        result.m_words[firstWord] &= ~Word{} << (first % wordWidth);
+        result.m_words[lastWord] &= ~Word{} >> (wordWidth - 1 - (last % wordWidth));
+        return result;
+    }
+
+    // Bits [first, first + resultBitCount) moved down to index 0 of a smaller bitset
+    template<std::size_t resultBitCount>
+    constexpr StaticBitset<resultBitCount> extract(std::size_t first) const noexcept
+    {
+        StaticBitset<resultBitCount> result{};
+
+        std::size_t const wordShift = first / wordWidth;
+        std::size_t const bitShift = first % wordWidth;
+        for (std::size_t i = 0; (i < StaticBitset<resultBitCount>::wordCount) && ((i + wordShift) < wordCount); ++i)
+        {
+            Word word = m_words[i + wordShift] >> bitShift;
+            if ((bitShift != 0) && ((i + wordShift + 1) < wordCount))
+            {
+                word |= m_words[i + wordShift + 1] << (wordWidth - bitShift);
+            }
+            result.m_words[i] = word;
+        }
+
+        result.clearUnusedBits();
+        return result;
+    }
+
+    constexpr unsigned long long to_ullong() const noexcept
+    {
+        if constexpr (wordCount > 0)
+        {
+            return m_words[0];
+        }
+        else
+        {
+            return 0;
+        }
+    }
+
+    constexpr Word word(std::size_t index) const noexcept
+    {
+        return m_words[index];
+    }
+
+    constexpr StaticBitset& operator&=(StaticBitset const& other) noexcept
+    {
+        details::BitsetKernels::bitwiseAnd(m_words.data(), other.m_words.data(), storageWordCount);
+        return *this;
+    }
+
+    constexpr StaticBitset& operator|=(StaticBitset const& other) noexcept
+    {
+        details::BitsetKernels::bitwiseOr(m_words.data(), other.m_words.data(), storageWordCount);
+        return *this;
+    }
+
+    constexpr StaticBitset& operator^=(StaticBitset const& other) noexcept
+    {
+        details::BitsetKernels::bitwiseXor(m_words.data(), other.m_words.data(), storageWordCount);
+        return *this;
+    }
+
+    // *this &= ~other, without materializing ~other
+    constexpr StaticBitset& andNot(StaticBitset const& other) noexcept
+    {
+        details::BitsetKernels::bitwiseAndNot(m_words.data(), other.m_words.data(), storageWordCount);
+        return *this;
+    }
+
+    constexpr StaticBitset& operator<<=(std::size_t shift) noexcept
+    {
+        if (shift >= bitCount)
+        {
+            return reset();
+        }
+
+        std::size_t const wordShift = shift / wordWidth;
+        std::size_t const bitShift = shift % wordWidth;
+        for (std::size_t i = wordCount; i-- > wordShift;)
+        {
+            Word word = m_words[i - wordShift] << bitShift;
+            if ((bitShift != 0) && (i > wordShift))
+            {
+                word |= m_words[i - wordShift - 1] >> (wordWidth - bitShift);
+            }
+            m_words[i] = word;
+        }
+
+        std::fill_n(m_words.begin(), wordShift, Word{});
+        clearUnusedBits();
+        return *this;
+    }
+
+    constexpr StaticBitset& operator>>=(std::size_t shift) noexcept
+    {
+        if (shift >= bitCount)
+        {
+            return reset();
+        }
+
+        std::size_t const wordShift = shift / wordWidth;
+        std::size_t const bitShift = shift % wordWidth;
+        std::size_t const lastWord = wordCount - wordShift;
+        for (std::size_t i = 0; i < lastWord; ++i)
+        {
+            Word word = m_words[i + wordShift] >> bitShift;
+            if ((bitShift != 0) && ((i + wordShift + 1) < wordCount))
+            {
+                word |= m_words[i + wordShift + 1] << (wordWidth - bitShift);
+            }
+            m_words[i] = word;
+        }
+
+        std::fill(m_words.begin() + lastWord, m_words.begin() + wordCount, Word{});
+        return *this;
+    }
+
+    constexpr StaticBitset operator~() const noexcept
+    {
+        return StaticBitset{ *this }.flip();
+    }
+
+    constexpr StaticBitset operator<<(std::size_t shift) const noexcept
+    {
+        return StaticBitset{ *this } <<= shift;
+    }
+
+    constexpr StaticBitset operator>>(std::size_t shift) const noexcept
+    {
+        return StaticBitset{ *this } >>= shift;
+    }
+
+    friend constexpr StaticBitset operator&(StaticBitset lhs, StaticBitset const& rhs) noexcept
+    {
+        return lhs &= rhs;
+    }
+
+    friend constexpr StaticBitset operator|(StaticBitset lhs, StaticBitset const& rhs) noexcept
+    {
+        return lhs |= rhs;
+    }
+
+    friend constexpr StaticBitset operator^(StaticBitset lhs, StaticBitset const& rhs) noexcept
+    {
+        return lhs ^= rhs;
+    }
+
+    friend constexpr bool operator==(StaticBitset const& lhs, StaticBitset const& rhs) noexcept
+    {
+        return details::BitsetKernels::equal(lhs.m_words.data(), rhs.m_words.data(), storageWordCount);
+    }
+
+protected:
+    // Bits past bitCount must be left cleared
+    constexpr Word& mutableWord(std::size_t index) noexcept
+    {
+        return m_words[index];
+    }
+
+private:
+    template<std::size_t>
+    friend class StaticBitset;
+
+    static constexpr std::size_t alignment = (storageWordCount >= details::BitsetKernels::vectorWordCount)
+                                           ? (details::BitsetKernels::vectorWordCount * sizeof(Word))
+                                           : alignof(Word);
+
+    alignas(alignment) std::array<Word, storageWordCount> m_words{};
+
+    constexpr void clearUnusedBits() noexcept
+    {
+        if constexpr ((bitCount % wordWidth) != 0)
+        {
+            m_words[wordCount - 1] &= (Word{ 1 } << (bitCount % wordWidth)) - 1;
+        }
+    }
+
+    constexpr std::size_t findFromWord(std::size_t wordIndex) const noexcept
+    {
+        for (; wordIndex < wordCount; ++wordIndex)
+        {
+            if (m_words[wordIndex] != 0)
+            {
+                return (wordIndex * wordWidth) + static_cast<std::size_t>(std::countr_zero(m_words[wordIndex]));
+            }
+        }
+
+        return bitCount;
+    }
+};
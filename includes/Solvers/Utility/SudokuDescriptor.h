@@ -5,53 +5,124 @@
 
 #pragma once
 
+#include <array>
 #include <bitset>
+#include <climits>
 #include <cstddef>
+#include <type_traits>
 
+#include "CandidateLayout.h"
+#include "CandidateTrail.h"
+#include "GridTopology.h"
 #include "SetBitIterator.h"
+#include "StaticBitset.h"
 
-template<typename Grid>
+namespace details
+{
+    // Bitsets whose operations can run during constant evaluation, so that mask tables are built at compile time
+    template<typename Bitset>
+    concept ConstexprBitset = requires { typename std::bool_constant<Bitset{}.set(0).test(0)>; };
+} // namespace details
+
+// Result of SudokuDescriptor::checkConsistency, naming the first contradiction found if any
+enum class Consistency
+{
+    Consistent,
+    EmptyCell,      // A cell has no candidate left
+    MissingValue,   // A value has no cell left in a house
+    DuplicateValue, // A value is placed twice in a house
+};
+
+// BitsetTemplate is any std::bitset-like class template taking its bit count, such as std::bitset itself.
+// LayoutTemplate decides where each (cell, value) candidate lives in the bitsets, see CandidateLayout.h.
+template<typename Grid
+       , template<std::size_t> class BitsetTemplate = StaticBitset
+       , template<typename> class LayoutTemplate = CellMajorLayout>
 class SudokuDescriptor
 {
 public:
     using Integer = Grid::Integer;
-    using Bitset = std::bitset<Grid::cellCount * Grid::maxValue>;
+    using Bitset = BitsetTemplate<Grid::cellCount * Grid::maxValue>;
+    using CellSet = BitsetTemplate<Grid::cellCount>;
+    using Layout = LayoutTemplate<Grid>;
+    using Topology = GridTopology<Grid>;
+
+    static constexpr std::size_t bitIndex(std::size_t cell, Integer value) noexcept
+    {
+        return Layout::bitIndex(cell, value);
+    }
+
+    static constexpr std::size_t bitToCell(std::size_t bit) noexcept
+    {
+        return Layout::bitToCell(bit);
+    }
+
+    static constexpr Integer bitToValue(std::size_t bit) noexcept
+    {
+        return static_cast<Integer>(Layout::bitToValue(bit));
+    }
 
     static Bitset cellMask(std::size_t index)
     {
-        static const Bitset mask = makeCellMask();
-        return mask << (index * Grid::maxValue);
+        if constexpr (tabulateCells)
+        {
+            return masks().cells[index];
+        }
+        else
+        {
+            Bitset mask{};
+            for (Integer value = 1; value <= Grid::maxValue; ++value)
+            {
+                mask.set(bitIndex(index, value));
+            }
+            return mask;
+        }
+    }
+
+    static Bitset const& columnMask(std::size_t x)
+    {
+        return masks().houses[Topology::columnHouse(x)];
     }
 
-    static Bitset columnMask(std::size_t x)
+    static Bitset const& rowMask(std::size_t y)
     {
-        static const Bitset mask = makeColumnMask();
-        return mask << (Grid::coordinatesToCell(x, 0) * Grid::maxValue);
+        return masks().houses[Topology::rowHouse(y)];
     }
 
-    static Bitset rowMask(std::size_t y)
+    static Bitset const& boxMask(std::size_t index)
     {
-        static const Bitset mask = makeRowMask();
-        return mask << (Grid::coordinatesToCell(0, y) * Grid::maxValue);
+        return masks().houses[Topology::boxHouse(index)];
     }
 
-    static Bitset boxMask(std::size_t index)
+    // House numbering is the one of GridTopology
+    static Bitset const& houseMask(std::size_t house)
     {
-        static const Bitset mask = makeBoxMask();
-        return mask << (Grid::boxIndexToTopLeftCell(index) * Grid::maxValue);
+        return masks().houses[house];
     }
 
+    // Cells of a house, indexed by cell
+    static CellSet const& houseCells(std::size_t house)
+    {
+        return masks().houseCells[house];
+    }
+
+    // The cell and all its peers
     static Bitset cellHousesMask(std::size_t cellIndex)
     {
-        return columnMask(Grid::cellToX(cellIndex))
-             | rowMask(Grid::cellToY(cellIndex))
-             | boxMask(Grid::cellToBoxIndex(cellIndex));
+        if constexpr (tabulateCells)
+        {
+            return masks().cellHouses[cellIndex];
+        }
+        else
+        {
+            auto const& [row, column, box] = Topology::cellHouses[cellIndex];
+            return houseMask(row) | houseMask(column) | houseMask(box);
+        }
     }
 
-    static Bitset valueMask(Integer value)
+    static Bitset const& valueMask(Integer value)
     {
-        static const Bitset mask = makeValueMask();
-        return mask << (value - 1);
+        return masks().values[value - 1];
     }
 
 public:
@@ -66,13 +137,7 @@ public:
         {
             if (value > 0)
             {
-                Bitset const mask = cellMask(i);
-                m_missingValues &= ~mask;
-
-                Bitset const gridValueMask = valueMask(value);
-                Bitset const restOfHousesMask = cellHousesMask(i) & ~mask;
-                m_possibilities &= ~(restOfHousesMask & gridValueMask);
-                m_possibilities &= gridValueMask | ~mask;
+                setValue(i, value);
             }
             ++i;
         }
@@ -82,12 +147,9 @@ public:
     {
         Grid grid;
 
-        for (auto it = SetBitIterator{ m_possibilities & ~m_missingValues }; it != SetBitIterator<Bitset>{}; ++it)
+        for (auto const bit : setBits(m_possibilities & ~m_missingValues))
         {
-            std::size_t const bitIndex = *it;
-            auto const cell = bitIndex / Grid::maxValue;
-            auto const value = 1 + (bitIndex % Grid::maxValue);
-            *(grid.begin() + cell) = value;
+            *(grid.begin() + bitToCell(bit)) = bitToValue(bit);
         }
 
         return grid;
@@ -95,7 +157,21 @@ public:
 
     Bitset possibilitiesForValue(Integer value) const
     {
-        return m_possibilities & valueMask(value);
+        if constexpr (hasExtractablePlanes)
+        {
+            // Only the words of the value's plane are read
+            return m_possibilities.keepRange(bitIndex(0, value), Grid::cellCount);
+        }
+        else
+        {
+            return m_possibilities & valueMask(value);
+        }
+    }
+
+    // Cells where value is still possible, indexed by cell
+    CellSet valueCells(Integer value) const
+    {
+        return planeCells(m_possibilities, value);
     }
 
     Bitset& possibilities()
@@ -118,60 +194,235 @@ public:
         return m_missingValues;
     }
 
-private:
-    Bitset m_missingValues;
-    Bitset m_possibilities;
-
-    static Bitset makeFirstCellsMask(std::size_t cellCount)
+    bool isFilled() const
     {
-        Bitset bitset{};
+        return m_missingValues.none();
+    }
 
-        bitset.set();
-        bitset >>= (Grid::cellCount - cellCount) * Grid::maxValue;
+    // Single pass stopping at the first contradiction found, which is the one reported. With value planes, each value
+    // is checked against every house with cell set operations; otherwise each cell's candidates are read as a word
+    // and merged into per-house words.
+    Consistency checkConsistency() const
+    {
+        if constexpr (hasExtractableCellWords)
+        {
+            return checkCellWordsConsistency();
+        }
+        else
+        {
+            return checkValuePlanesConsistency();
+        }
+    }
 
-        return bitset;
+    bool isContradiction() const
+    {
+        return checkConsistency() != Consistency::Consistent;
     }
 
-    static Bitset makeRowMask()
+    // With TrailedBitset, the words modified from now on are saved to the trail, which undoes them down to any of its
+    // marks. Strategies keep working on the descriptor as usual. nullptr stops recording.
+    void setTrail(CandidateTrail* trail)
+        requires requires(Bitset& bitset, CandidateTrail* other) { bitset.setTrail(other); }
     {
-        return makeFirstCellsMask(Grid::columnCount);
+        m_missingValues.setTrail(trail);
+        m_possibilities.setTrail(trail);
     }
 
-    static Bitset makeCellMask()
+    // Places value in the cell and removes it from the possibilities of the cell's houses
+    void setValue(std::size_t cell, Integer value)
     {
-        return makeFirstCellsMask(1);
+        Bitset const mask = cellMask(cell);
+        m_missingValues &= ~mask;
+
+        Bitset const gridValueMask = valueMask(value);
+        Bitset const restOfHousesMask = cellHousesMask(cell) & ~mask;
+        m_possibilities &= ~(restOfHousesMask & gridValueMask);
+        m_possibilities &= gridValueMask | ~mask;
     }
 
-    static Bitset makeRepeatedPatternMask(Bitset const& pattern, std::size_t repeatSpan, std::size_t repeatCount)
+private:
+    Bitset m_missingValues;
+    Bitset m_possibilities;
+
+    Consistency checkValuePlanesConsistency() const
     {
-        Bitset bitset{};
+        // Placing a value clears all the missing bits of its cell
+        CellSet const placedCells = ~planeCells(m_missingValues, 1);
 
-        for (std::size_t y = 0; y < repeatCount; ++y)
+        CellSet candidateCells{};
+        for (Integer value = 1; value <= Grid::maxValue; ++value)
         {
-            bitset <<= repeatSpan;
-            bitset |= pattern;
+            CellSet const cells = valueCells(value);
+            CellSet const placed = cells & placedCells;
+            bool const mayBeDuplicated = placed.count() > 1;
+            candidateCells |= cells;
+
+            for (std::size_t house = 0; house < Topology::houseCount; ++house)
+            {
+                CellSet const& houseCells = masks().houseCells[house];
+                if ((houseCells & cells).none())
+                {
+                    return Consistency::MissingValue;
+                }
+
+                if (mayBeDuplicated && ((houseCells & placed).count() > 1))
+                {
+                    return Consistency::DuplicateValue;
+                }
+            }
         }
 
-        return bitset;
+        return candidateCells.all() ? Consistency::Consistent : Consistency::EmptyCell;
     }
 
-    static Bitset makeFirstCellsOfEachRowMask(std::size_t cellCount, std::size_t rowCount)
+    Consistency checkCellWordsConsistency() const
     {
-        return makeRepeatedPatternMask(makeFirstCellsMask(cellCount), Grid::columnCount * Grid::maxValue, rowCount);
+        using Word = std::remove_cvref_t<decltype(m_possibilities.template extract<Grid::maxValue>(0).word(0))>;
+        constexpr Word allValues = (Grid::maxValue == (sizeof(Word) * CHAR_BIT))
+                                 ? ~Word{}
+                                 : static_cast<Word>((Word{ 1 } << Grid::maxValue) - 1);
+
+        std::array<Word, Topology::houseCount> houseValues{};
+        std::array<Word, Topology::houseCount> housePlacedValues{};
+        for (std::size_t cell = 0; cell < Grid::cellCount; ++cell)
+        {
+            Word const values = m_possibilities.template extract<Grid::maxValue>(bitIndex(cell, 1)).word(0);
+            if (values == 0)
+            {
+                return Consistency::EmptyCell;
+            }
+
+            // Placing a value clears all the missing bits of its cell
+            bool const isPlaced = !m_missingValues.test(bitIndex(cell, 1));
+            for (auto house : Topology::cellHouses[cell])
+            {
+                if (isPlaced)
+                {
+                    if ((housePlacedValues[house] & values) != 0)
+                    {
+                        return Consistency::DuplicateValue;
+                    }
+                    housePlacedValues[house] |= values;
+                }
+                houseValues[house] |= values;
+            }
+        }
+
+        for (auto values : houseValues)
+        {
+            if (values != allValues)
+            {
+                return Consistency::MissingValue;
+            }
+        }
+
+        return Consistency::Consistent;
     }
 
-    static Bitset makeColumnMask()
+    // Cells whose bit for value is set in bits, indexed by cell
+    static CellSet planeCells(Bitset const& bits, Integer value)
     {
-        return makeFirstCellsOfEachRowMask(1, Grid::rowCount);
+        if constexpr (hasExtractablePlanes)
+        {
+            return bits.template extract<Grid::cellCount>(bitIndex(0, value));
+        }
+        else
+        {
+            CellSet cells{};
+            for (std::size_t cell = 0; cell < Grid::cellCount; ++cell)
+            {
+                cells.set(cell, bits.test(bitIndex(cell, value)));
+            }
+            return cells;
+        }
     }
 
-    static Bitset makeBoxMask()
+    static constexpr bool hasExtractablePlanes = Layout::hasValuePlanes
+                                              && requires(Bitset const& bitset)
+                                                 {
+                                                     bitset.keepRange(0, 0);
+                                                     bitset.template extract<Grid::cellCount>(0);
+                                                 };
+
+    // A cell's candidates are contiguous and fit in a single word of the bitset
+    static constexpr bool hasExtractableCellWords = !Layout::hasValuePlanes
+                                                 && requires(Bitset const& bitset)
+                                                    {
+                                                        bitset.template extract<Grid::maxValue>(0).word(0);
+                                                    }
+                                                 && (Grid::maxValue <= 64);
+
+    // Per-cell tables are only kept while they stay reasonably small (up to 16x16 grids)
+    static constexpr bool tabulateCells = (2 * Grid::cellCount * sizeof(Bitset)) <= (1 << 20);
+    static constexpr std::size_t tabulatedCellCount = tabulateCells ? Grid::cellCount : 0;
+
+    struct Masks
     {
-        return makeFirstCellsOfEachRowMask(Grid::boxWidth, Grid::boxHeight);
+        std::array<Bitset, tabulatedCellCount> cells{};
+        std::array<Bitset, tabulatedCellCount> cellHouses{};
+        std::array<Bitset, Topology::houseCount> houses{};
+        std::array<CellSet, Topology::houseCount> houseCells{};
+        std::array<Bitset, Grid::maxValue> values{};
+    };
+
+    static constexpr Masks makeMasks()
+    {
+        Masks result{};
+
+        for (std::size_t cell = 0; cell < Grid::cellCount; ++cell)
+        {
+            for (auto house : Topology::cellHouses[cell])
+            {
+                result.houseCells[house].set(cell);
+            }
+
+            for (std::size_t value = 1; value <= Grid::maxValue; ++value)
+            {
+                std::size_t const bit = bitIndex(cell, static_cast<Integer>(value));
+                result.values[value - 1].set(bit);
+                for (auto house : Topology::cellHouses[cell])
+                {
+                    result.houses[house].set(bit);
+                }
+
+                if constexpr (tabulateCells)
+                {
+                    result.cells[cell].set(bit);
+                }
+            }
+        }
+
+        if constexpr (tabulateCells)
+        {
+            for (std::size_t cell = 0; cell < Grid::cellCount; ++cell)
+            {
+                for (auto house : Topology::cellHouses[cell])
+                {
+                    result.cellHouses[cell] |= result.houses[house];
+                }
+            }
+        }
+
+        return result;
     }
 
-    static Bitset makeValueMask()
+    // Only instantiated for bitsets usable in constant expressions
+    static constexpr Masks constantMasks = makeMasks();
+
+    static Masks const& masks()
     {
-        return makeRepeatedPatternMask(Bitset{}.set(0), Grid::maxValue, Grid::cellCount);
+        if constexpr (details::ConstexprBitset<Bitset>)
+        {
+            return constantMasks;
+        }
+        else
+        {
+            static Masks const runtimeMasks = makeMasks();
+            return runtimeMasks;
+        }
     }
 };
+
+// Descriptor whose candidate changes can be recorded to a CandidateTrail and rolled back, see setTrail
+template<typename Grid, template<typename> class LayoutTemplate = CellMajorLayout>
+using TrailedSudokuDescriptor = SudokuDescriptor<Grid, TrailedBitset, LayoutTemplate>;
@@ -11,7 +11,9 @@
 #include <concepts>
 #include <cstddef>
 #include <functional>
+#include <initializer_list>
 #include <type_traits>
+#include <utility>
 #include <version>
 
 namespace details
@@ -124,18 +126,14 @@ public:
             }
 
             auto const [x, y] = cellToCoordinates(i);
-            std::array<std::reference_wrapper<std::bitset<maxValue>>, 3> const toCheck = {
-                columnChecks[x], rowChecks[y], boxChecks[cellToBoxIndex(i)]
-            };
-
-            for (auto& bitset : toCheck)
+            for (auto* checks : { &columnChecks[x], &rowChecks[y], &boxChecks[cellToBoxIndex(i)] })
             {
-                if (bitset.get().test(val - 1))
+                if (checks->test(val - 1))
                 {
                     return false;
                 }
 
-                bitset.get().set(val - 1);
+                checks->set(val - 1);
             }
         }
 
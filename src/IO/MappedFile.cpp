@@ -0,0 +1,207 @@
+// Copyright 2022 DrSinIsIn (axel.gaillard.dev@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "IO/MappedFile.h"
+
+#include <cerrno>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+#include <utility>
+
+#if __has_include(<sys/mman.h>)
+#define SUDOKU_SOLVER_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+#ifdef SUDOKU_SOLVER_HAS_MMAP
+    [[noreturn]] void throwLastError(char const* what)
+    {
+        throw std::system_error{ errno, std::generic_category(), what };
+    }
+
+    // Closes the descriptor once the mapping exists, which keeps the file alive by itself
+    struct FileDescriptor
+    {
+        int value = -1;
+
+        ~FileDescriptor()
+        {
+            if (value >= 0)
+            {
+                ::close(value);
+            }
+        }
+    };
+#endif
+}
+
+MappedFile MappedFile::openForReading(std::filesystem::path const& path)
+{
+    MappedFile result;
+
+#ifdef SUDOKU_SOLVER_HAS_MMAP
+    FileDescriptor const file{ ::open(path.c_str(), O_RDONLY) };
+    if (file.value < 0)
+    {
+        throwLastError("open");
+    }
+
+    struct stat status{};
+    if (::fstat(file.value, &status) != 0)
+    {
+        throwLastError("fstat");
+    }
+
+    result.m_size = static_cast<std::size_t>(status.st_size);
+    if (result.m_size > 0)
+    {
+        void* const data = ::mmap(nullptr, result.m_size, PROT_READ, MAP_PRIVATE, file.value, 0);
+        if (data == MAP_FAILED)
+        {
+            throwLastError("mmap");
+        }
+
+        // Lines are parsed front to back
+        ::madvise(data, result.m_size, MADV_SEQUENTIAL);
+        result.m_data = static_cast<char*>(data);
+    }
+#else
+    std::ifstream stream{ path, std::ios::binary };
+    if (!stream)
+    {
+        throw std::system_error{ std::make_error_code(std::errc::no_such_file_or_directory), "open" };
+    }
+
+    result.m_buffer.assign(std::istreambuf_iterator<char>{ stream }, std::istreambuf_iterator<char>{});
+    result.m_data = result.m_buffer.data();
+    result.m_size = result.m_buffer.size();
+#endif
+
+    return result;
+}
+
+MappedFile MappedFile::createForWriting(std::filesystem::path const& path, std::size_t size)
+{
+    MappedFile result;
+    result.m_isWritable = true;
+    result.m_size = size;
+
+#ifdef SUDOKU_SOLVER_HAS_MMAP
+    FileDescriptor const file{ ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644) };
+    if (file.value < 0)
+    {
+        throwLastError("open");
+    }
+
+    if (::ftruncate(file.value, static_cast<off_t>(size)) != 0)
+    {
+        throwLastError("ftruncate");
+    }
+
+    if (size > 0)
+    {
+        void* const data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file.value, 0);
+        if (data == MAP_FAILED)
+        {
+            throwLastError("mmap");
+        }
+
+        result.m_data = static_cast<char*>(data);
+    }
+#else
+    result.m_path = path;
+    result.m_buffer.resize(size);
+    result.m_data = result.m_buffer.data();
+    result.flush();
+#endif
+
+    return result;
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : m_data{ std::exchange(other.m_data, nullptr) }
+    , m_size{ std::exchange(other.m_size, 0) }
+    , m_isWritable{ std::exchange(other.m_isWritable, false) }
+    , m_path{ std::move(other.m_path) }
+    , m_buffer{ std::move(other.m_buffer) }
+{}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        close();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_isWritable = std::exchange(other.m_isWritable, false);
+        m_path = std::move(other.m_path);
+        m_buffer = std::move(other.m_buffer);
+    }
+
+    return *this;
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+void MappedFile::flush()
+{
+    if (!m_isWritable)
+    {
+        return;
+    }
+
+#ifdef SUDOKU_SOLVER_HAS_MMAP
+    if ((m_data != nullptr) && (::msync(m_data, m_size, MS_SYNC) != 0))
+    {
+        throwLastError("msync");
+    }
+#else
+    std::ofstream stream{ m_path, std::ios::binary | std::ios::trunc };
+    stream.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+    if (!stream)
+    {
+        throw std::system_error{ std::make_error_code(std::errc::io_error), "write" };
+    }
+#endif
+}
+
+void MappedFile::close() noexcept
+{
+#ifdef SUDOKU_SOLVER_HAS_MMAP
+    if (m_data != nullptr)
+    {
+        if (m_isWritable)
+        {
+            ::msync(m_data, m_size, MS_SYNC);
+        }
+
+        ::munmap(m_data, m_size);
+    }
+#else
+    if (m_isWritable)
+    {
+        try
+        {
+            flush();
+        }
+        catch (...)
+        {
+        }
+    }
+#endif
+
+    m_data = nullptr;
+    m_size = 0;
+    m_isWritable = false;
+}
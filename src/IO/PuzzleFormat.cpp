@@ -0,0 +1,60 @@
+// Copyright 2022 DrSinIsIn (axel.gaillard.dev@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "IO/PuzzleFormat.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace details
+{
+    bool decodeDigits(char const* text, std::size_t count, std::uint8_t* values) noexcept
+    {
+        std::size_t i = 0;
+
+#if defined(__SSE2__) || defined(_M_X64)
+        __m128i const zero = _mm_set1_epi8('0');
+        __m128i const dot = _mm_set1_epi8('.');
+        __m128i const nine = _mm_set1_epi8(9);
+
+        for (; (i + 16) <= count; i += 16)
+        {
+            __m128i const chars = _mm_loadu_si128(reinterpret_cast<__m128i const*>(text + i));
+
+            // '.' wraps around when subtracting '0', so it is cleared afterwards; anything else must land in 0-9
+            __m128i const isDot = _mm_cmpeq_epi8(chars, dot);
+            __m128i const digits = _mm_andnot_si128(isDot, _mm_sub_epi8(chars, zero));
+            __m128i const isDigit = _mm_cmpeq_epi8(_mm_max_epu8(digits, nine), nine);
+
+            if (_mm_movemask_epi8(isDigit) != 0xFFFF)
+            {
+                return false;
+            }
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(values + i), digits);
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            char const c = text[i];
+            if (c == '.')
+            {
+                values[i] = 0;
+            }
+            else if ((c >= '0') && (c <= '9'))
+            {
+                values[i] = static_cast<std::uint8_t>(c - '0');
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
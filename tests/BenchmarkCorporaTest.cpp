@@ -0,0 +1,76 @@
+// Copyright 2022 DrSinIsIn (axel.gaillard.dev@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <gtest/gtest.h>
+
+#include "IO/PuzzleFileReader.h"
+#include "Solvers/DifficultyGrading.h"
+#include "Sudoku.h"
+
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    using SRSudoku9x9 = StaticRegularSudoku<unsigned, 3, 3>;
+    using SRSudoku16x16 = StaticRegularSudoku<unsigned, 4, 4>;
+
+    // Same order as the corpora of SudokuSolver_Benchmarks
+    constexpr std::array<std::string_view, 4> tierNames{ "easy", "medium", "hard", "diabolical" };
+
+    // Singles; then locked candidates and pairs; then triples and fish; then guessing
+    std::string_view tierOf(Grade const& grade)
+    {
+        if (grade.guessed)
+        {
+            return tierNames[3];
+        }
+        if (!grade.hardest || (*grade.hardest <= Technique::HiddenSingle))
+        {
+            return tierNames[0];
+        }
+        if (*grade.hardest <= Technique::HiddenPair)
+        {
+            return tierNames[1];
+        }
+        return tierNames[2];
+    }
+
+    // Every puzzle of each corpus is solved, and needs exactly the techniques of its tier
+    template<typename Grid>
+    void checkTiers(std::string_view gridName)
+    {
+        for (auto const tier : tierNames)
+        {
+            std::filesystem::path const path = std::filesystem::path{ SUDOKU_SOLVER_CORPORA_DIR }
+                                             / (std::string{ gridName } + '_' + std::string{ tier } + ".txt");
+            std::vector<Grid> const puzzles = PuzzleFileReader<Grid>{ path }.readAll();
+            ASSERT_FALSE(puzzles.empty()) << path;
+
+            std::vector<Grade> grades(puzzles.size());
+            gradeBatch<Grid>(puzzles, grades);
+            for (std::size_t i = 0; i < grades.size(); ++i)
+            {
+                ASSERT_TRUE(grades[i].solved) << path << ':' << (i + 1);
+                ASSERT_EQ(::tierOf(grades[i]), tier) << path << ':' << (i + 1);
+            }
+        }
+    }
+}
+
+TEST(BenchmarkCorporaTest, tiers9x9)
+{
+    ::checkTiers<SRSudoku9x9>("9x9");
+}
+
+TEST(BenchmarkCorporaTest, tiers16x16)
+{
+    ::checkTiers<SRSudoku16x16>("16x16");
+}
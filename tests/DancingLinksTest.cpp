@@ -0,0 +1,95 @@
+// Copyright 2022 DrSinIsIn (axel.gaillard.dev@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <gtest/gtest.h>
+
+#include "Solvers/Utility/DancingLinks.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace
+{
+    // Knuth's example, whose only exact cover is made of rows 0, 3 and 4
+    DancingLinks makeKnuthExample()
+    {
+        std::vector<std::vector<std::size_t>> const rows{ { 2, 4, 5 }
+                                                        , { 0, 3, 6 }
+                                                        , { 1, 2, 5 }
+                                                        , { 0, 3 }
+                                                        , { 1, 6 }
+                                                        , { 3, 4, 6 } };
+
+        DancingLinks links{ 7, 16 };
+        for (auto const& row : rows)
+        {
+            links.addRow(row);
+        }
+
+        return links;
+    }
+}
+
+TEST(DancingLinksTest, search)
+{
+    DancingLinks links = ::makeKnuthExample();
+    ASSERT_EQ(links.columnCount(), 7);
+    ASSERT_EQ(links.rowCount(), 6);
+
+    std::vector<std::size_t> solution;
+    auto const count = links.search(2, [&](std::span<std::size_t const> rows)
+    {
+        solution.assign(rows.begin(), rows.end());
+        return true;
+    });
+
+    ASSERT_EQ(count, 1);
+    std::ranges::sort(solution);
+    ASSERT_EQ(solution, (std::vector<std::size_t>{ 0, 3, 4 }));
+
+    // The matrix is restored after each search
+    ASSERT_EQ(links.countSolutions(10), 1);
+}
+
+TEST(DancingLinksTest, select)
+{
+    {
+        // Row 3 is part of the solution, selecting it keeps it
+        DancingLinks links = ::makeKnuthExample();
+        ASSERT_TRUE(links.select(3));
+        ASSERT_EQ(links.countSolutions(10), 1);
+    }
+
+    {
+        // Row 1 is not, and conflicts with row 3
+        DancingLinks links = ::makeKnuthExample();
+        ASSERT_TRUE(links.select(1));
+        ASSERT_EQ(links.countSolutions(10), 0);
+        ASSERT_FALSE(links.select(3));
+    }
+}
+
+TEST(DancingLinksTest, limit)
+{
+    // Every column is covered by either of two rows, hence 2^3 exact covers
+    DancingLinks links{ 3 };
+    for (std::size_t column = 0; column < 3; ++column)
+    {
+        std::array<std::size_t, 1> const columns{ column };
+        links.addRow(columns);
+        links.addRow(columns);
+    }
+
+    ASSERT_EQ(links.countSolutions(100), 8);
+    ASSERT_EQ(links.countSolutions(5), 5);
+
+    // Stopping from the callback
+    std::size_t calls = 0;
+    ASSERT_EQ(links.search(100, [&](std::span<std::size_t const>) { return ++calls < 3; }), 3);
+    ASSERT_EQ(links.countSolutions(100), 8);
+}
@@ -0,0 +1,126 @@
+// Copyright 2022 DrSinIsIn (axel.gaillard.dev@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <gtest/gtest.h>
+
+#include "Solvers/Utility/GridTopology.h"
+#include "Solvers/Utility/SudokuDescriptor.h"
+#include "Sudoku.h"
+
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <set>
+
+namespace
+{
+    using SRSudoku9x9 = StaticRegularSudoku<unsigned, 3, 3>;
+    using SRSudoku6x6 = StaticRegularSudoku<unsigned, 3, 2>;
+
+    template<typename Grid>
+    void checkTopology()
+    {
+        using Topology = GridTopology<Grid>;
+
+        for (std::size_t cell = 0; cell < Grid::cellCount; ++cell)
+        {
+            auto const [row, column, box] = Topology::cellHouses[cell];
+            ASSERT_EQ(row, Topology::rowHouse(Grid::cellToY(cell)));
+            ASSERT_EQ(column, Topology::columnHouse(Grid::cellToX(cell)));
+            ASSERT_EQ(box, Topology::boxHouse(Grid::cellToBoxIndex(cell)));
+
+            // Each house of the cell lists it
+            for (auto house : Topology::cellHouses[cell])
+            {
+                ASSERT_NE(std::ranges::find(Topology::houseCells[house], cell), Topology::houseCells[house].end());
+            }
+
+            // Peers are all distinct, and share a house with the cell
+            auto const& peers = Topology::cellPeers[cell];
+            std::set<std::size_t> const uniquePeers{ peers.begin(), peers.end() };
+            ASSERT_EQ(uniquePeers.size(), Topology::peerCount);
+            ASSERT_FALSE(uniquePeers.contains(cell));
+
+            for (auto peer : peers)
+            {
+                ASSERT_TRUE((Grid::cellToX(peer) == Grid::cellToX(cell))
+                         || (Grid::cellToY(peer) == Grid::cellToY(cell))
+                         || (Grid::cellToBoxIndex(peer) == Grid::cellToBoxIndex(cell)));
+            }
+        }
+
+        // Every house covers distinct cells
+        for (auto const& cells : Topology::houseCells)
+        {
+            std::set<std::size_t> const uniqueCells{ cells.begin(), cells.end() };
+            ASSERT_EQ(uniqueCells.size(), Topology::houseSize);
+        }
+    }
+
+    template<typename Descriptor, typename Grid>
+    void checkDescriptorMasks()
+    {
+        using Bitset = typename Descriptor::Bitset;
+        using Topology = GridTopology<Grid>;
+
+        for (std::size_t house = 0; house < Topology::houseCount; ++house)
+        {
+            Bitset expected{};
+            for (auto cell : Topology::houseCells[house])
+            {
+                expected |= Descriptor::cellMask(cell);
+            }
+
+            ASSERT_EQ(Descriptor::houseMask(house), expected);
+        }
+
+        for (std::size_t cell = 0; cell < Grid::cellCount; ++cell)
+        {
+            Bitset expected = Descriptor::cellMask(cell);
+            for (auto peer : Topology::cellPeers[cell])
+            {
+                expected |= Descriptor::cellMask(peer);
+            }
+
+            ASSERT_EQ(Descriptor::cellHousesMask(cell), expected);
+            ASSERT_EQ(Descriptor::cellMask(cell).count(), Grid::maxValue);
+
+            for (unsigned value = 1; value <= Grid::maxValue; ++value)
+            {
+                ASSERT_TRUE((Descriptor::cellMask(cell) & Descriptor::valueMask(value))
+                                .test(Descriptor::bitIndex(cell, value)));
+            }
+        }
+    }
+}
+
+TEST(GridTopologyTest, regularGrid)
+{
+    checkTopology<SRSudoku9x9>();
+    checkDescriptorMasks<SudokuDescriptor<SRSudoku9x9>, SRSudoku9x9>();
+    checkDescriptorMasks<SudokuDescriptor<SRSudoku9x9, std::bitset>, SRSudoku9x9>();
+    checkDescriptorMasks<SudokuDescriptor<SRSudoku9x9, StaticBitset, ValueMajorLayout>, SRSudoku9x9>();
+}
+
+TEST(GridTopologyTest, rectangularBoxes)
+{
+    checkTopology<SRSudoku6x6>();
+    checkDescriptorMasks<SudokuDescriptor<SRSudoku6x6>, SRSudoku6x6>();
+}
+
+TEST(GridTopologyTest, largeGrid)
+{
+    using SRSudoku25x25 = StaticRegularSudoku<unsigned, 5, 5>;
+
+    checkTopology<SRSudoku25x25>();
+
+    // Per-cell masks are computed on the fly at this size, and must agree with the house tables
+    using Descriptor = SudokuDescriptor<SRSudoku25x25>;
+    auto const cell = SRSudoku25x25::coordinatesToCell(7, 12);
+    auto const [row, column, box] = GridTopology<SRSudoku25x25>::cellHouses[cell];
+    ASSERT_EQ(Descriptor::cellMask(cell), Descriptor::houseMask(row) & Descriptor::houseMask(column));
+    ASSERT_EQ(Descriptor::cellHousesMask(cell).count(), (GridTopology<SRSudoku25x25>::peerCount + 1) * 25);
+    ASSERT_TRUE(Descriptor::boxMask(box - (2 * 25)).test(Descriptor::bitIndex(cell, 3)));
+}
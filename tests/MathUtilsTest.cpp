@@ -9,7 +9,9 @@
 
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <cstddef>
+#include <cstdint>
 #include <set>
 
 namespace
@@ -47,3 +49,31 @@ TEST(MathUtilsTest, nChooseR)
     ASSERT_EQ(current, firstSubsetOf3);
     ASSERT_EQ(results.size(), 10);
 }
+
+TEST(MathUtilsTest, boundedUnionCombinations)
+{
+    std::array<std::uint16_t, 7> const masks{ 0b0011, 0b0110, 0b1000'0000, 0b0101, 0b0001, 0b1111'0000, 0b1010 };
+
+    // Every combination of 3 masks whose union has at most 4 bits, found by brute force
+    std::set<std::array<std::size_t, 3>> expected;
+    std::array<std::size_t, 3> combination{ 0, 1, 2 };
+    do
+    {
+        auto const unionMask = masks[combination[0]] | masks[combination[1]] | masks[combination[2]];
+        if (std::popcount(static_cast<unsigned>(unionMask)) <= 4)
+        {
+            expected.insert(combination);
+        }
+    }
+    while (MathUtils::nextCombination<7>(combination));
+
+    std::set<std::array<std::size_t, 3>> found;
+    for (auto const& bounded : MathUtils::BoundedUnionCombinations<3, std::uint16_t>{ masks, 4 })
+    {
+        ASSERT_EQ(bounded.unionMask, masks[bounded.indices[0]] | masks[bounded.indices[1]] | masks[bounded.indices[2]]);
+        ASSERT_TRUE(found.insert(bounded.indices).second);
+    }
+
+    ASSERT_FALSE(expected.empty());
+    ASSERT_EQ(found, expected);
+}
@@ -0,0 +1,167 @@
+// Copyright 2022 DrSinIsIn (axel.gaillard.dev@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <gtest/gtest.h>
+
+#include "IO/PuzzleFileReader.h"
+#include "IO/PuzzleFileWriter.h"
+#include "IO/PuzzleFormat.h"
+#include "Solvers/Utility/SudokuDescriptor.h"
+#include "Sudoku.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace
+{
+    using SRSudoku9x9 = StaticRegularSudoku<unsigned, 3, 3>;
+    using SRSudoku16x16 = StaticRegularSudoku<unsigned, 4, 4>;
+    using SRSudoku25x25 = StaticRegularSudoku<unsigned, 5, 5>;
+
+    constexpr std::string_view puzzleLine = "8..........36......7..9.2...5...7.......457.....1...3...1....68..85...1..9....4..";
+    constexpr std::string_view zeroPuzzleLine = "800000000003600000070090200050007000000045700000100030001000068008500010090000400";
+
+    inline constexpr SRSudoku9x9 puzzle { 8, 0, 0, 0, 0, 0, 0, 0, 0, //
+                                          0, 0, 3, 6, 0, 0, 0, 0, 0, //
+                                          0, 7, 0, 0, 9, 0, 2, 0, 0, //
+                                          0, 5, 0, 0, 0, 7, 0, 0, 0, //
+                                          0, 0, 0, 0, 4, 5, 7, 0, 0, //
+                                          0, 0, 0, 1, 0, 0, 0, 3, 0, //
+                                          0, 0, 1, 0, 0, 0, 0, 6, 8, //
+                                          0, 0, 8, 5, 0, 0, 0, 1, 0, //
+                                          0, 9, 0, 0, 0, 0, 4, 0, 0 };
+
+    std::filesystem::path temporaryFile(std::string const& name)
+    {
+        return std::filesystem::temp_directory_path() / ("SudokuSolver_" + name);
+    }
+
+    void writeText(std::filesystem::path const& path, std::string_view text)
+    {
+        std::ofstream stream{ path, std::ios::binary | std::ios::trunc };
+        stream << text;
+    }
+
+    template<typename Grid>
+    void checkRoundTrip()
+    {
+        using Alphabet = PuzzleAlphabet<Grid>;
+
+        Grid grid;
+        for (std::size_t i = 0; auto& value : grid)
+        {
+            value = static_cast<typename Grid::Integer>((i * 7) % (Grid::maxValue + 1));
+            ++i;
+        }
+
+        std::string text(Grid::cellCount, ' ');
+        Alphabet::encode(grid, text.data());
+
+        Grid decoded;
+        ASSERT_TRUE(Alphabet::decode(text, decoded));
+        ASSERT_TRUE(std::ranges::equal(decoded, grid));
+    }
+}
+
+TEST(PuzzleFileTest, decodeDigits)
+{
+    SRSudoku9x9 grid;
+    ASSERT_TRUE(PuzzleAlphabet<SRSudoku9x9>::decode(::puzzleLine, grid));
+    ASSERT_TRUE(std::ranges::equal(grid, ::puzzle));
+
+    SRSudoku9x9 zeroGrid;
+    ASSERT_TRUE(PuzzleAlphabet<SRSudoku9x9>::decode(::zeroPuzzleLine, zeroGrid));
+    ASSERT_TRUE(std::ranges::equal(zeroGrid, ::puzzle));
+
+    // Bad character in the vectorized part, in the scalar tail, and wrong length
+    std::string badLine{ ::puzzleLine };
+    badLine[5] = 'x';
+    ASSERT_FALSE(PuzzleAlphabet<SRSudoku9x9>::decode(badLine, grid));
+
+    badLine = ::puzzleLine;
+    badLine[80] = '/';
+    ASSERT_FALSE(PuzzleAlphabet<SRSudoku9x9>::decode(badLine, grid));
+    ASSERT_FALSE(PuzzleAlphabet<SRSudoku9x9>::decode(::puzzleLine.substr(1), grid));
+}
+
+TEST(PuzzleFileTest, largerAlphabets)
+{
+    ASSERT_EQ(PuzzleAlphabet<SRSudoku16x16>::valueToChar(9), '9');
+    ASSERT_EQ(PuzzleAlphabet<SRSudoku16x16>::valueToChar(16), 'G');
+    ASSERT_EQ(PuzzleAlphabet<SRSudoku16x16>::decodeTable['a'], 10);
+    ASSERT_EQ(PuzzleAlphabet<SRSudoku16x16>::decodeTable['H'], PuzzleAlphabet<SRSudoku16x16>::invalid);
+
+    ASSERT_EQ(PuzzleAlphabet<SRSudoku25x25>::valueToChar(1), 'A');
+    ASSERT_EQ(PuzzleAlphabet<SRSudoku25x25>::valueToChar(25), 'Y');
+    ASSERT_EQ(PuzzleAlphabet<SRSudoku25x25>::decodeTable['0'], 0);
+    ASSERT_EQ(PuzzleAlphabet<SRSudoku25x25>::decodeTable['Z'], PuzzleAlphabet<SRSudoku25x25>::invalid);
+
+    checkRoundTrip<SRSudoku9x9>();
+    checkRoundTrip<SRSudoku16x16>();
+    checkRoundTrip<SRSudoku25x25>();
+}
+
+TEST(PuzzleFileTest, readFile)
+{
+    auto const path = ::temporaryFile("readFile.txt");
+    writeText(path, std::string{ ::puzzleLine } + "\r\n\n" + std::string{ ::zeroPuzzleLine });
+
+    {
+        PuzzleFileReader<SRSudoku9x9> reader{ path };
+        auto const grids = reader.readAll();
+        ASSERT_EQ(grids.size(), 2);
+        ASSERT_TRUE(std::ranges::equal(grids[0], ::puzzle));
+        ASSERT_TRUE(std::ranges::equal(grids[1], ::puzzle));
+        ASSERT_EQ(reader.lineNumber(), 3);
+    }
+
+    {
+        // Straight into descriptors
+        PuzzleFileReader<SRSudoku9x9> reader{ path };
+        SudokuDescriptor<SRSudoku9x9> descriptor;
+        ASSERT_TRUE(reader.next(descriptor));
+        ASSERT_TRUE(std::ranges::equal(SRSudoku9x9{ descriptor }, ::puzzle));
+    }
+
+    writeText(path, std::string{ ::puzzleLine } + "\n" + std::string{ ::puzzleLine.substr(3) } + "\n");
+    {
+        PuzzleFileReader<SRSudoku9x9> reader{ path };
+        SRSudoku9x9 grid;
+        ASSERT_TRUE(reader.next(grid));
+        ASSERT_THROW(reader.next(grid), std::invalid_argument);
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST(PuzzleFileTest, writeFile)
+{
+    auto const path = ::temporaryFile("writeFile.txt");
+
+    {
+        PuzzleFileWriter<SRSudoku9x9> writer{ path, 3 };
+        ASSERT_EQ(writer.size(), 3);
+
+        // Any order
+        writer.write(2, ::puzzle);
+        writer.write(0, ::puzzle);
+        writer.write(1, SRSudoku9x9{});
+    }
+
+    ASSERT_EQ(std::filesystem::file_size(path), 3 * 82);
+
+    PuzzleFileReader<SRSudoku9x9> reader{ path };
+    auto const grids = reader.readAll();
+    ASSERT_EQ(grids.size(), 3);
+    ASSERT_TRUE(std::ranges::equal(grids[0], ::puzzle));
+    ASSERT_TRUE(std::ranges::equal(grids[1], SRSudoku9x9{}));
+    ASSERT_TRUE(std::ranges::equal(grids[2], ::puzzle));
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,120 @@
+// Copyright 2022 DrSinIsIn (axel.gaillard.dev@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <gtest/gtest.h>
+
+#include "Solvers/PuzzleGenerator.h"
+#include "Solvers/SolutionCounting.h"
+#include "Sudoku.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    using SRSudoku6x6 = StaticRegularSudoku<unsigned, 3, 2>;
+    using SRSudoku9x9 = StaticRegularSudoku<unsigned, 3, 3>;
+
+    // Solved grid, whose clues are all in the puzzle
+    template<typename Grid>
+    void checkPuzzle(Grid const& puzzle, Grid const& solution)
+    {
+        ASSERT_TRUE(solution.isSolved());
+        ASSERT_TRUE(hasUniqueSolution(puzzle));
+        for (std::size_t cell = 0; cell < Grid::cellCount; ++cell)
+        {
+            auto const clue = *(puzzle.begin() + cell);
+            ASSERT_TRUE((clue == 0) || (clue == *(solution.begin() + cell)));
+        }
+    }
+
+    template<typename Grid>
+    std::size_t clueCount(Grid const& puzzle)
+    {
+        return Grid::cellCount - static_cast<std::size_t>(std::ranges::count(puzzle, 0u));
+    }
+}
+
+TEST(PuzzleGeneratorTest, fullGrid)
+{
+    PuzzleGenerator<SRSudoku9x9> generator{ 42 };
+    SRSudoku9x9 const grid = generator.fullGrid();
+    ASSERT_TRUE(grid.isSolved());
+
+    // Same seed, same grid; other grids afterwards
+    ASSERT_TRUE(std::ranges::equal(PuzzleGenerator<SRSudoku9x9>{ 42 }.fullGrid(), grid));
+    ASSERT_FALSE(std::ranges::equal(generator.fullGrid(), grid));
+
+    ASSERT_TRUE(PuzzleGenerator<SRSudoku6x6>{ 7 }.fullGrid().isSolved());
+}
+
+TEST(PuzzleGeneratorTest, generate)
+{
+    PuzzleGenerator<SRSudoku9x9> generator{ 3 };
+    SRSudoku9x9 const solution = generator.fullGrid();
+    SRSudoku9x9 const puzzle = generator.removeClues(solution);
+    ::checkPuzzle(puzzle, solution);
+
+    // No clue can be removed anymore
+    for (std::size_t cell = 0; cell < SRSudoku9x9::cellCount; ++cell)
+    {
+        if (*(puzzle.begin() + cell) != 0)
+        {
+            SRSudoku9x9 smaller = puzzle;
+            *(smaller.begin() + cell) = 0;
+            ASSERT_EQ(countSolutions(smaller, 2), 2);
+        }
+    }
+
+    ASSERT_TRUE(hasUniqueSolution(PuzzleGenerator<SRSudoku6x6>{ 5 }.generate()));
+}
+
+TEST(PuzzleGeneratorTest, symmetry)
+{
+    PuzzleGenerator<SRSudoku9x9> generator{ 11 };
+    for (auto const symmetry : { ClueSymmetry::Rotational, ClueSymmetry::Mirror, ClueSymmetry::Diagonal })
+    {
+        SRSudoku9x9 const solution = generator.fullGrid();
+        SRSudoku9x9 const puzzle = generator.removeClues(solution, symmetry);
+        ::checkPuzzle(puzzle, solution);
+
+        for (std::size_t cell = 0; cell < SRSudoku9x9::cellCount; ++cell)
+        {
+            auto const [x, y] = SRSudoku9x9::cellToCoordinates(cell);
+            auto const [otherX, otherY] = (symmetry == ClueSymmetry::Rotational) ? std::pair{ 8 - x, 8 - y }
+                                        : (symmetry == ClueSymmetry::Mirror)     ? std::pair{ 8 - x, y }
+                                                                                 : std::pair{ y, x };
+            std::size_t const other = SRSudoku9x9::coordinatesToCell(otherX, otherY);
+            ASSERT_EQ(*(puzzle.begin() + cell) == 0, *(puzzle.begin() + other) == 0);
+        }
+    }
+}
+
+TEST(PuzzleGeneratorTest, generateBatch)
+{
+    GenerationOptions const options{ .seed = 2022, .symmetry = ClueSymmetry::Rotational };
+
+    std::vector<SRSudoku9x9> puzzles(8);
+    generateBatch(std::span{ puzzles }, options, BatchOptions{ .threadCount = 3 });
+
+    // Each puzzle only depends on the seed and its index, not on the thread count
+    std::vector<SRSudoku9x9> singleThreaded(puzzles.size());
+    generateBatch(std::span{ singleThreaded }, options, BatchOptions{ .threadCount = 1 });
+
+    for (std::size_t i = 0; i < puzzles.size(); ++i)
+    {
+        ASSERT_TRUE(std::ranges::equal(puzzles[i], singleThreaded[i]));
+        ASSERT_TRUE(hasUniqueSolution(puzzles[i]));
+        ASSERT_LT(::clueCount(puzzles[i]), SRSudoku9x9::cellCount / 2);
+
+        PuzzleGenerator<SRSudoku9x9> generator{ details::puzzleSeed(options.seed, i) };
+        ASSERT_TRUE(std::ranges::equal(generator.generate(options.symmetry), puzzles[i]));
+    }
+
+    ASSERT_FALSE(std::ranges::equal(puzzles[0], puzzles[1]));
+}
@@ -6,9 +6,12 @@
 #include <gtest/gtest.h>
 
 #include "Solvers/Utility/SetBitIterator.h"
+#include "Solvers/Utility/StaticBitset.h"
 
 #include <algorithm>
 #include <bitset>
+#include <type_traits>
+#include <vector>
 
 namespace
 {
@@ -70,3 +73,58 @@ TEST(SetBitIteratorTest, largeBitsetIteration)
 
     ASSERT_EQ(count, ::largeBitset.count());
 }
+
+TEST(SetBitIteratorTest, setBitsOfTemporary)
+{
+    std::vector<std::size_t> indices;
+    for (auto index : setBits(::largeBitset & ~(::largeBitset << 1)))
+    {
+        indices.push_back(index);
+    }
+
+    std::vector<std::size_t> expected;
+    for (std::size_t i = 0; i < ::largeBitset.size(); ++i)
+    {
+        if (::largeBitset.test(i) && ((i == 0) || !::largeBitset.test(i - 1)))
+        {
+            expected.push_back(i);
+        }
+    }
+
+    ASSERT_EQ(indices, expected);
+}
+
+TEST(SetBitIteratorTest, setBitsOfStaticBitset)
+{
+    StaticBitset<160> bitset{};
+    for (std::size_t i = 0; i < ::largeBitset.size(); ++i)
+    {
+        bitset.set(i, ::largeBitset.test(i));
+    }
+
+    std::vector<std::size_t> indices;
+    for (auto index : setBits(bitset))
+    {
+        indices.push_back(index);
+    }
+
+    std::vector<std::size_t> expected;
+    for (auto index : setBits(::largeBitset))
+    {
+        expected.push_back(index);
+    }
+
+    ASSERT_EQ(indices.size(), ::largeBitset.count());
+    ASSERT_EQ(indices, expected);
+    ASSERT_TRUE(std::ranges::is_sorted(indices));
+    ASSERT_TRUE(setBits(StaticBitset<160>{}).begin() == std::default_sentinel);
+}
+
+TEST(SetBitIteratorTest, noTemporaries)
+{
+    // Iterators refer to their bitset, so that they can't be built from temporaries
+    static_assert(std::is_constructible_v<SetBitIterator<StaticBitset<160>>, StaticBitset<160>&>);
+    static_assert(std::is_constructible_v<SetBitIterator<StaticBitset<160>>, StaticBitset<160> const&>);
+    static_assert(!std::is_constructible_v<SetBitIterator<StaticBitset<160>>, StaticBitset<160>>);
+    static_assert(!std::is_constructible_v<SetBitIterator<std::bitset<10>>, std::bitset<10>&&>);
+}
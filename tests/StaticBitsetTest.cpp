@@ -0,0 +1,161 @@
+// Copyright 2022 DrSinIsIn (axel.gaillard.dev@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <gtest/gtest.h>
+
+#include "Solvers/Utility/StaticBitset.h"
+
+#include <bitset>
+#include <cstddef>
+#include <random>
+
+namespace
+{
+    template<std::size_t bitCount>
+    struct RandomPair
+    {
+        std::bitset<bitCount> reference;
+        StaticBitset<bitCount> subject;
+    };
+
+    template<std::size_t bitCount>
+    RandomPair<bitCount> makeRandomPair(std::mt19937_64& engine)
+    {
+        RandomPair<bitCount> result;
+        std::bernoulli_distribution distribution{ 0.3 };
+        for (std::size_t i = 0; i < bitCount; ++i)
+        {
+            bool const value = distribution(engine);
+            result.reference.set(i, value);
+            result.subject.set(i, value);
+        }
+
+        return result;
+    }
+
+    template<std::size_t bitCount>
+    ::testing::AssertionResult isSame(std::bitset<bitCount> const& reference, StaticBitset<bitCount> const& subject)
+    {
+        for (std::size_t i = 0; i < bitCount; ++i)
+        {
+            if (reference.test(i) != subject.test(i))
+            {
+                return ::testing::AssertionFailure() << "bit " << i << " differs";
+            }
+        }
+
+        if (reference.count() != subject.count())
+        {
+            return ::testing::AssertionFailure() << "counts differ";
+        }
+
+        return ::testing::AssertionSuccess();
+    }
+
+    template<std::size_t bitCount>
+    void checkAgainstStdBitset()
+    {
+        std::mt19937_64 engine{ bitCount };
+
+        for (int i = 0; i < 20; ++i)
+        {
+            auto const [referenceA, subjectA] = makeRandomPair<bitCount>(engine);
+            auto const [referenceB, subjectB] = makeRandomPair<bitCount>(engine);
+
+            ASSERT_TRUE(isSame(referenceA & referenceB, subjectA & subjectB));
+            ASSERT_TRUE(isSame(referenceA | referenceB, subjectA | subjectB));
+            ASSERT_TRUE(isSame(referenceA ^ referenceB, subjectA ^ subjectB));
+            ASSERT_TRUE(isSame(~referenceA, ~subjectA));
+            ASSERT_TRUE(isSame(referenceA & ~referenceB, StaticBitset{ subjectA }.andNot(subjectB)));
+            ASSERT_EQ((referenceA & referenceB).none(), (subjectA & subjectB).none());
+            ASSERT_EQ(subjectA == subjectB, referenceA == referenceB);
+            ASSERT_TRUE(subjectA == StaticBitset{ subjectA });
+
+            for (std::size_t shift : { std::size_t{ 0 }, std::size_t{ 1 }, std::size_t{ 9 }, std::size_t{ 63 }
+                                     , std::size_t{ 64 }, std::size_t{ 65 }, bitCount / 2, bitCount - 1, bitCount })
+            {
+                ASSERT_TRUE(isSame(referenceA << shift, subjectA << shift));
+                ASSERT_TRUE(isSame(referenceA >> shift, subjectA >> shift));
+            }
+        }
+    }
+}
+
+TEST(StaticBitsetTest, matchesStdBitset)
+{
+    checkAgainstStdBitset<10>();
+    checkAgainstStdBitset<160>();
+    checkAgainstStdBitset<729>();
+    checkAgainstStdBitset<4096>();
+}
+
+TEST(StaticBitsetTest, setAndReset)
+{
+    StaticBitset<729> bitset;
+    ASSERT_TRUE(bitset.none());
+
+    bitset.set();
+    ASSERT_TRUE(bitset.all());
+    ASSERT_EQ(bitset.count(), 729);
+
+    bitset.reset(728);
+    ASSERT_FALSE(bitset.all());
+    ASSERT_EQ(bitset.count(), 728);
+
+    bitset.reset();
+    ASSERT_TRUE(bitset.none());
+    ASSERT_EQ(StaticBitset<729>{ 0b1011 }.count(), 3);
+}
+
+TEST(StaticBitsetTest, findFirstAndNext)
+{
+    StaticBitset<729> bitset;
+    ASSERT_EQ(bitset.findFirst(), bitset.size());
+
+    bitset.set(3).set(64).set(200).set(728);
+
+    ASSERT_EQ(bitset.findFirst(), 3);
+    ASSERT_EQ(bitset.findNext(3), 64);
+    ASSERT_EQ(bitset.findNext(64), 200);
+    ASSERT_EQ(bitset.findNext(100), 200);
+    ASSERT_EQ(bitset.findNext(200), 728);
+    ASSERT_EQ(bitset.findNext(728), bitset.size());
+}
+
+TEST(StaticBitsetTest, rangeExtraction)
+{
+    std::mt19937_64 engine{ 42 };
+    auto const [reference, subject] = makeRandomPair<729>(engine);
+
+    for (std::size_t first : { 0, 1, 63, 64, 81, 200, 648 })
+    {
+        auto const kept = subject.keepRange(first, 81);
+        auto const extracted = subject.extract<81>(first);
+        for (std::size_t i = 0; i < 729; ++i)
+        {
+            bool const inRange = (i >= first) && (i < (first + 81));
+            ASSERT_EQ(kept.test(i), inRange && reference.test(i));
+        }
+
+        for (std::size_t i = 0; i < 81; ++i)
+        {
+            ASSERT_EQ(extracted.test(i), reference.test(first + i));
+        }
+
+        ASSERT_EQ(kept.count(), extracted.count());
+    }
+
+    // Extracting past the end pads with zeros
+    ASSERT_EQ(subject.extract<81>(700).count(), (reference >> 700).count());
+}
+
+TEST(StaticBitsetTest, constantEvaluation)
+{
+    constexpr auto shifted = (StaticBitset<729>{ 0b101 } << 700) | StaticBitset<729>{ 1 };
+    static_assert(shifted.count() == 3);
+    static_assert(shifted.test(700) && shifted.test(702) && shifted.test(0));
+    static_assert(shifted.findNext(0) == 700);
+    static_assert((~shifted).count() == 726);
+}
@@ -6,10 +6,13 @@
 #include <gtest/gtest.h>
 
 #include "Sudoku.h"
+#include "Solvers/Utility/CompactSudokuDescriptor.h"
 #include "Solvers/Utility/SudokuDescriptor.h"
 
 #include <algorithm>
 #include <array>
+#include <bitset>
+#include <cstddef>
 
 namespace
 {
@@ -24,6 +27,39 @@ namespace
                                               0, 0, 7, 2, 0, 0, 0, 8, 0, //
                                               0, 2, 6, 0, 0, 0, 0, 3, 5, //
                                               0, 0, 0, 4, 0, 9, 0, 0, 0 };
+
+    // Each contradiction is made alone on an empty grid, so that it is the only one to be reported
+    template<typename Descriptor>
+    void checkConsistency()
+    {
+        ASSERT_EQ(Descriptor{ ::subjectGrid }.checkConsistency(), Consistency::Consistent);
+        ASSERT_FALSE(Descriptor{ SRSudoku9x9{} }.isContradiction());
+
+        Descriptor emptyCell{ SRSudoku9x9{} };
+        emptyCell.possibilities() &= ~emptyCell.cellMask(40);
+        ASSERT_EQ(emptyCell.checkConsistency(), Consistency::EmptyCell);
+        ASSERT_TRUE(emptyCell.isContradiction());
+
+        Descriptor missingValue{ SRSudoku9x9{} };
+        missingValue.possibilities() &= ~(missingValue.rowMask(3) & missingValue.valueMask(5));
+        ASSERT_EQ(missingValue.checkConsistency(), Consistency::MissingValue);
+
+        // 5 placed in the first two cells of row 0, without removing it from their peers
+        Descriptor duplicateValue{ SRSudoku9x9{} };
+        for (std::size_t cell : { 0, 1 })
+        {
+            auto const cellMask = duplicateValue.cellMask(cell);
+            duplicateValue.possibilities() &= ~cellMask | duplicateValue.valueMask(5);
+            duplicateValue.missingValuesMask() &= ~cellMask;
+        }
+        ASSERT_EQ(duplicateValue.checkConsistency(), Consistency::DuplicateValue);
+
+        // Placing a value removes it from the peers, emptying a peer where it was placed already
+        Descriptor placedTwice{ SRSudoku9x9{} };
+        placedTwice.setValue(0, 5);
+        placedTwice.setValue(1, 5);
+        ASSERT_TRUE(placedTwice.isContradiction());
+    }
 }
 
 TEST(StaticRegularSudokuDescriptorTest, descriptor)
@@ -94,3 +130,125 @@ TEST(StaticRegularSudokuDescriptorTest, modifyingDescriptor)
     // New value should have been set in the resulting grid
     ASSERT_EQ(*(resultGrid.begin() + cellIndex70), 9);
 }
+
+TEST(StaticRegularSudokuDescriptorTest, valueMajorLayout)
+{
+    SudokuDescriptor<SRSudoku9x9> const cellMajor{ ::subjectGrid };
+    SudokuDescriptor<SRSudoku9x9, StaticBitset, ValueMajorLayout> const valueMajor{ ::subjectGrid };
+    SudokuDescriptor<SRSudoku9x9, std::bitset, ValueMajorLayout> const stdValueMajor{ ::subjectGrid };
+
+    // Same candidates, whatever the layout
+    for (unsigned value = 1; value <= SRSudoku9x9::maxValue; ++value)
+    {
+        auto const cells = cellMajor.valueCells(value);
+        ASSERT_EQ(cells, valueMajor.valueCells(value));
+        ASSERT_EQ(cells.count(), cellMajor.possibilitiesForValue(value).count());
+        ASSERT_EQ(cells.count(), valueMajor.possibilitiesForValue(value).count());
+        ASSERT_EQ(cells.count(), stdValueMajor.valueCells(value).count());
+
+        for (std::size_t cell = 0; cell < SRSudoku9x9::cellCount; ++cell)
+        {
+            ASSERT_EQ(cells.test(cell), valueMajor.possibilities().test(valueMajor.bitIndex(cell, value)));
+        }
+    }
+
+    // A value plane is contiguous
+    ASSERT_EQ(valueMajor.valueMask(2).findFirst(), SRSudoku9x9::cellCount);
+    ASSERT_EQ(valueMajor.bitToCell(valueMajor.bitIndex(40, 7)), 40);
+    ASSERT_EQ(valueMajor.bitToValue(valueMajor.bitIndex(40, 7)), 7);
+
+    // Converting back
+    SRSudoku9x9 const resultGrid = valueMajor;
+    auto [mismatchIt, _] = std::ranges::mismatch(resultGrid, ::subjectGrid);
+    ASSERT_EQ(mismatchIt, resultGrid.end());
+}
+
+TEST(StaticRegularSudokuDescriptorTest, compactDescriptor)
+{
+    SudokuDescriptor<SRSudoku9x9> const descriptor{ ::subjectGrid };
+    CompactSudokuDescriptor<SRSudoku9x9> const compactDescriptor{ ::subjectGrid };
+
+    static_assert(sizeof(CompactSudokuDescriptor<SRSudoku9x9>::Candidates) == 2);
+
+    for (std::size_t cell = 0; cell < SRSudoku9x9::cellCount; ++cell)
+    {
+        // Same candidates as the bitset descriptor
+        for (unsigned value = 1; value <= SRSudoku9x9::maxValue; ++value)
+        {
+            bool const isPossible = (compactDescriptor.candidates(cell) & compactDescriptor.valueBit(value)) != 0;
+            ASSERT_EQ(isPossible, descriptor.possibilities().test(descriptor.bitIndex(cell, value)));
+        }
+
+        ASSERT_EQ(compactDescriptor.value(cell), *(::subjectGrid.begin() + cell));
+    }
+
+    // Cell at (0, 3) holds 1, so 1 is placed in row 0
+    ASSERT_NE(compactDescriptor.placedValues(0) & compactDescriptor.valueBit(1), 0);
+    ASSERT_EQ(compactDescriptor.placedValues(0) & compactDescriptor.valueBit(9), 0);
+
+    // Round trips through both representations
+    auto const converted = compactDescriptor.toDescriptor<SudokuDescriptor<SRSudoku9x9>>();
+    ASSERT_EQ(converted.possibilities(), descriptor.possibilities());
+    ASSERT_EQ(converted.missingValuesMask(), descriptor.missingValuesMask());
+
+    CompactSudokuDescriptor<SRSudoku9x9> const fromDescriptor{ descriptor };
+    ASSERT_EQ(fromDescriptor.candidates(), compactDescriptor.candidates());
+
+    SRSudoku9x9 const resultGrid = fromDescriptor;
+    auto [mismatchIt, _] = std::ranges::mismatch(resultGrid, ::subjectGrid);
+    ASSERT_EQ(mismatchIt, resultGrid.end());
+}
+
+TEST(StaticRegularSudokuDescriptorTest, checkConsistency)
+{
+    ::checkConsistency<SudokuDescriptor<SRSudoku9x9>>();
+    ::checkConsistency<SudokuDescriptor<SRSudoku9x9, StaticBitset, ValueMajorLayout>>();
+    ::checkConsistency<SudokuDescriptor<SRSudoku9x9, std::bitset>>();
+}
+
+TEST(StaticRegularSudokuDescriptorTest, trailRollback)
+{
+    using Descriptor = TrailedSudokuDescriptor<SRSudoku9x9>;
+    Descriptor descriptor{ ::subjectGrid };
+    Descriptor const startDescriptor{ descriptor };
+
+    CandidateTrail trail;
+    descriptor.setTrail(&trail);
+    auto const startMark = trail.mark();
+
+    // Placing a value only saves the words it modifies
+    auto const cellIndex00 = ::subjectGrid.coordinatesToCell(0, 0);
+    descriptor.setValue(cellIndex00, 2);
+    ASSERT_GT(trail.size(), startMark);
+    ASSERT_LE(trail.size(), 2 * Descriptor::Bitset::wordCount);
+
+    auto const placedMark = trail.mark();
+    SudokuDescriptor<SRSudoku9x9> placed{ ::subjectGrid };
+    placed.setValue(cellIndex00, 2);
+
+    // Strategies modify the bitsets directly
+    auto const cellIndex88 = ::subjectGrid.coordinatesToCell(8, 8);
+    descriptor.possibilities().reset(descriptor.bitIndex(cellIndex88, 7));
+    descriptor.possibilities() &= ~descriptor.rowMask(4);
+    ASSERT_TRUE(descriptor.isContradiction());
+
+    trail.rollback(placedMark);
+    ASSERT_EQ(descriptor.possibilities(), placed.possibilities());
+    ASSERT_EQ(descriptor.missingValuesMask(), placed.missingValuesMask());
+
+    trail.rollback(startMark);
+    ASSERT_EQ(trail.size(), startMark);
+    ASSERT_EQ(descriptor.possibilities(), startDescriptor.possibilities());
+    ASSERT_EQ(descriptor.missingValuesMask(), startDescriptor.missingValuesMask());
+
+    // Copies don't record to the trail
+    Descriptor copy{ descriptor };
+    copy.setValue(cellIndex00, 2);
+    ASSERT_EQ(trail.size(), startMark);
+
+    // Neither does the descriptor once detached from it
+    descriptor.setTrail(nullptr);
+    descriptor.setValue(cellIndex00, 2);
+    ASSERT_EQ(trail.size(), startMark);
+    ASSERT_EQ(descriptor.possibilities(), placed.possibilities());
+}
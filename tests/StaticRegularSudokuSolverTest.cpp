@@ -5,19 +5,39 @@
 
 #include <gtest/gtest.h>
 
+#include "Solvers/BacktrackingSolver.h"
 #include "Solvers/BasicFishSolver.h"
+#include "Solvers/BatchSolver.h"
+#include "Solvers/BatchSolving.h"
+#include "Solvers/DancingLinksSolver.h"
+#include "Solvers/DifficultyGrading.h"
+#include "Solvers/FinnedFishSolver.h"
 #include "Solvers/HiddenTupleSolver.h"
 #include "Solvers/LockedCandidatesSolver.h"
 #include "Solvers/NakedSingleSolver.h"
+#include "Solvers/NakedTupleSolver.h"
+#include "Solvers/SolutionCounting.h"
+#include "Solvers/SolverPipeline.h"
+#include "Solvers/StrategyChain.h"
+#include "Solvers/Utility/CompactSudokuDescriptor.h"
+#include "Solvers/Utility/GridTopology.h"
 #include "Solvers/Utility/SudokuDescriptor.h"
 #include "Sudoku.h"
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <bitset>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace
 {
     using SRSudoku9x9 = StaticRegularSudoku<unsigned, 3, 3>;
+    using SRSudoku16x16 = StaticRegularSudoku<unsigned, 4, 4>;
 
     inline constexpr SRSudoku9x9 pureNakedSingleSolvable{ 0, 0, 0, 1, 0, 5, 0, 0, 0, //
                                                           1, 4, 0, 0, 0, 0, 6, 7, 0, //
@@ -58,6 +78,185 @@ namespace
                                                 0, 3, 0, 0, 4, 2, 5, 6, 0, //
                                                 0, 2, 4, 0, 0, 5, 9, 0, 0, //
                                                 5, 0, 7, 0, 0, 9, 2, 4, 0 };
+
+    inline constexpr SRSudoku9x9 logicResistant { 8, 0, 0, 0, 0, 0, 0, 0, 0, //
+                                                  0, 0, 3, 6, 0, 0, 0, 0, 0, //
+                                                  0, 7, 0, 0, 9, 0, 2, 0, 0, //
+                                                  0, 5, 0, 0, 0, 7, 0, 0, 0, //
+                                                  0, 0, 0, 0, 4, 5, 7, 0, 0, //
+                                                  0, 0, 0, 1, 0, 0, 0, 3, 0, //
+                                                  0, 0, 1, 0, 0, 0, 0, 6, 8, //
+                                                  0, 0, 8, 5, 0, 0, 0, 1, 0, //
+                                                  0, 9, 0, 0, 0, 0, 4, 0, 0 };
+
+    inline constexpr SRSudoku9x9 logicResistantSolution { 8, 1, 2, 7, 5, 3, 6, 4, 9, //
+                                                          9, 4, 3, 6, 8, 2, 1, 7, 5, //
+                                                          6, 7, 5, 4, 9, 1, 2, 8, 3, //
+                                                          1, 5, 4, 2, 3, 7, 8, 9, 6, //
+                                                          3, 6, 9, 8, 4, 5, 7, 2, 1, //
+                                                          2, 8, 7, 1, 6, 9, 5, 3, 4, //
+                                                          5, 2, 1, 9, 7, 4, 3, 6, 8, //
+                                                          4, 3, 8, 5, 2, 6, 9, 1, 7, //
+                                                          7, 9, 6, 3, 1, 8, 4, 5, 2 };
+
+    // Valid clues, but the last cell of the first row can only be 9 which its column already has
+    inline constexpr SRSudoku9x9 noSolution { 1, 2, 3, 4, 5, 6, 7, 8, 0, //
+                                              0, 0, 0, 0, 0, 0, 0, 0, 9, //
+                                              0, 0, 0, 0, 0, 0, 0, 0, 0, //
+                                              0, 0, 0, 0, 0, 0, 0, 0, 0, //
+                                              0, 0, 0, 0, 0, 0, 0, 0, 0, //
+                                              0, 0, 0, 0, 0, 0, 0, 0, 0, //
+                                              0, 0, 0, 0, 0, 0, 0, 0, 0, //
+                                              0, 0, 0, 0, 0, 0, 0, 0, 0, //
+                                              0, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+    // Runs the solver once on descriptor, then checks that it removed exactly the candidates isRemoved(cell, value)
+    // tells among the possible ones, and that running it again removes nothing more
+    template<typename Solver, typename Grid, typename IsRemoved>
+    void checkRemovedCandidates(SudokuDescriptor<Grid>& descriptor, IsRemoved const& isRemoved)
+    {
+        SudokuDescriptor<Grid> const startDescriptor{ descriptor };
+
+        Solver solver;
+        ASSERT_TRUE(solver.solveOnce(descriptor));
+
+        for (std::size_t cell = 0; cell < Grid::cellCount; ++cell)
+        {
+            for (unsigned value = 1; value <= Grid::maxValue; ++value)
+            {
+                auto const bit = descriptor.bitIndex(cell, value);
+                bool const wasPossible = startDescriptor.possibilities().test(bit);
+                ASSERT_EQ(descriptor.possibilities().test(bit), wasPossible && !isRemoved(cell, value));
+            }
+        }
+
+        // Nothing left to remove
+        ASSERT_FALSE(solver.solveOnce(descriptor));
+    }
+
+    // Starts from an empty grid where value only remains, in the base lines, at their crossings with the cover lines,
+    // then checks that the fish solver removes value from the rest of the cover lines, and nothing else
+    template<typename Solver, typename Grid>
+    void checkFish(std::vector<std::size_t> const& baseLines
+                 , std::vector<std::size_t> const& coverLines
+                 , unsigned value
+                 , bool baseLinesAreRows)
+    {
+        auto const cellAt = [&](std::size_t baseLine, std::size_t coverLine)
+        {
+            return baseLinesAreRows ? Grid::coordinatesToCell(coverLine, baseLine)
+                                    : Grid::coordinatesToCell(baseLine, coverLine);
+        };
+
+        SudokuDescriptor<Grid> descriptor{ Grid{} };
+        for (auto baseLine : baseLines)
+        {
+            for (std::size_t line = 0; line < Grid::maxValue; ++line)
+            {
+                if (std::ranges::find(coverLines, line) == coverLines.end())
+                {
+                    descriptor.possibilities().reset(descriptor.bitIndex(cellAt(baseLine, line), value));
+                }
+            }
+        }
+
+        ::checkRemovedCandidates<Solver>(descriptor, [&](std::size_t cell, unsigned candidate)
+        {
+            auto const [x, y] = Grid::cellToCoordinates(cell);
+            auto const baseLine = baseLinesAreRows ? y : x;
+            auto const coverLine = baseLinesAreRows ? x : y;
+            return (candidate == value)
+                && (std::ranges::find(coverLines, coverLine) != coverLines.end())
+                && (std::ranges::find(baseLines, baseLine) == baseLines.end());
+        });
+    }
+
+    // Starts from an empty grid where the tuple values only remain, in the house, in the tuple cells, then checks that
+    // the hidden tuple solver removes every other value from the tuple cells, and nothing else
+    template<typename Solver, typename Grid>
+    void checkHiddenTuple(std::size_t house
+                        , std::vector<std::size_t> const& tupleCells
+                        , std::vector<unsigned> const& values)
+    {
+        SudokuDescriptor<Grid> descriptor{ Grid{} };
+        for (auto cell : GridTopology<Grid>::houseCells[house])
+        {
+            if (std::ranges::find(tupleCells, cell) == tupleCells.end())
+            {
+                for (auto value : values)
+                {
+                    descriptor.possibilities().reset(descriptor.bitIndex(cell, value));
+                }
+            }
+        }
+
+        ::checkRemovedCandidates<Solver>(descriptor, [&](std::size_t cell, unsigned value)
+        {
+            return (std::ranges::find(tupleCells, cell) != tupleCells.end())
+                && (std::ranges::find(values, value) == values.end());
+        });
+    }
+
+    // Starts from an empty grid where the tuple cells only have the given candidates, then checks that the naked
+    // tuple solver removes the tuple's values from the cells sharing a house with all of them, and only from these
+    template<typename Solver, typename Grid>
+    void checkNakedTuple(std::vector<std::size_t> const& tupleCells, std::vector<std::vector<unsigned>> const& values)
+    {
+        using Topology = GridTopology<Grid>;
+
+        SudokuDescriptor<Grid> descriptor{ Grid{} };
+        std::vector<unsigned> tupleValues;
+        for (std::size_t i = 0; i < tupleCells.size(); ++i)
+        {
+            for (unsigned value = 1; value <= Grid::maxValue; ++value)
+            {
+                if (std::ranges::find(values[i], value) == values[i].end())
+                {
+                    descriptor.possibilities().reset(descriptor.bitIndex(tupleCells[i], value));
+                }
+                else if (std::ranges::find(tupleValues, value) == tupleValues.end())
+                {
+                    tupleValues.push_back(value);
+                }
+            }
+        }
+
+        ::checkRemovedCandidates<Solver>(descriptor, [&](std::size_t cell, unsigned value)
+        {
+            bool const seesTuple = std::ranges::any_of(Topology::cellHouses[cell], [&](std::size_t house)
+            {
+                auto const& houseCells = Topology::houseCells[house];
+                return std::ranges::all_of(tupleCells, [&](std::size_t tupleCell)
+                {
+                    return std::ranges::find(houseCells, tupleCell) != houseCells.end();
+                });
+            });
+
+            return (std::ranges::find(tupleCells, cell) == tupleCells.end())
+                && seesTuple
+                && (std::ranges::find(tupleValues, value) != tupleValues.end());
+        });
+    }
+
+    // Runs singles and the given solvers to a fixpoint on a puzzle logic can't solve, then checks that whatever has
+    // been removed, the value of the solution is still possible in every cell
+    template<typename... Solvers>
+    void checkKeepsSolution()
+    {
+        SolverPipeline<SRSudoku9x9> pipeline;
+        pipeline.add<NakedSingleSolver<SRSudoku9x9>>();
+        pipeline.add<HiddenSingleSolver<SRSudoku9x9>>();
+        (pipeline.add<Solvers>(), ...);
+
+        SudokuDescriptor<SRSudoku9x9> descriptor{ ::logicResistant };
+        pipeline.solve(descriptor);
+
+        for (std::size_t cell = 0; cell < SRSudoku9x9::cellCount; ++cell)
+        {
+            auto const value = *(::logicResistantSolution.begin() + cell);
+            ASSERT_TRUE(descriptor.possibilities().test(descriptor.bitIndex(cell, value)));
+        }
+    }
 }
 
 TEST(StaticRegularSudokuSolverTest, nakedSingleSolver_solveOnce)
@@ -299,6 +498,47 @@ TEST(StaticRegularSudokuSolverTest, hiddenPairSolver_solveOnce)
     }
 }
 
+TEST(StaticRegularSudokuSolverTest, hiddenTupleSolver_lastValue)
+{
+    using Topology9x9 = GridTopology<SRSudoku9x9>;
+    using Topology16x16 = GridTopology<SRSudoku16x16>;
+
+    // The largest value is as much a candidate as the others: singles in a row and a column, a pair and a triple in
+    // boxes, all of them holding it
+    ::checkHiddenTuple<HiddenSingleSolver<SRSudoku9x9>, SRSudoku9x9>(Topology9x9::rowHouse(0), { 4 }, { 9 });
+    ::checkHiddenTuple<HiddenSingleSolver<SRSudoku16x16>, SRSudoku16x16>(Topology16x16::columnHouse(3), { 83 }, { 16 });
+    ::checkHiddenTuple<HiddenTupleSolver<2, SRSudoku9x9>, SRSudoku9x9>(Topology9x9::boxHouse(4), { 30, 50 }, { 8, 9 });
+    ::checkHiddenTuple<HiddenTupleSolver<3, SRSudoku9x9>, SRSudoku9x9>(Topology9x9::boxHouse(8)
+                                                                    , { 60, 70, 80 }
+                                                                    , { 1, 5, 9 });
+}
+
+TEST(StaticRegularSudokuSolverTest, hiddenTupleSolver_keepsSolution)
+{
+    ::checkKeepsSolution<HiddenTupleSolver<2, SRSudoku9x9>
+                       , HiddenTupleSolver<3, SRSudoku9x9>
+                       , HiddenTupleSolver<4, SRSudoku9x9>>();
+}
+
+TEST(StaticRegularSudokuSolverTest, nakedTupleSolver_solveOnce)
+{
+    // Pair in a row and a box, then in a column only
+    ::checkNakedTuple<NakedPairSolver<SRSudoku9x9>, SRSudoku9x9>({ 0, 1 }, { { 1, 2 }, { 1, 2 } });
+    ::checkNakedTuple<NakedPairSolver<SRSudoku9x9>, SRSudoku9x9>({ 4, 76 }, { { 3, 8 }, { 3, 8 } });
+
+    // No cell of a triple or a quad needs to hold all of its values
+    ::checkNakedTuple<NakedTripleSolver<SRSudoku9x9>, SRSudoku9x9>({ 36, 40, 44 }, { { 1, 2 }, { 2, 3 }, { 1, 3 } });
+    ::checkNakedTuple<NakedQuadSolver<SRSudoku16x16>, SRSudoku16x16>({ 0, 17, 34, 51 }
+                                                                    , { { 5, 9 }, { 9, 12 }, { 12, 16 }, { 5, 16 } });
+}
+
+TEST(StaticRegularSudokuSolverTest, nakedTupleSolver_keepsSolution)
+{
+    ::checkKeepsSolution<NakedTupleSolver<2, SRSudoku9x9>
+                       , NakedTupleSolver<3, SRSudoku9x9>
+                       , NakedTupleSolver<4, SRSudoku9x9>>();
+}
+
 TEST(StaticRegularSudokuSolverTest, lockedCandidatesSolver_solveOnce)
 {
     LockedCandidatesSolver<SRSudoku9x9> solver;
@@ -366,3 +606,730 @@ TEST(StaticRegularSudokuSolverTest, xWingSolver_solveOnce)
         ASSERT_TRUE(possibilityAtCell.none());
     }
 }
+
+TEST(StaticRegularSudokuSolverTest, swordfishSolver_solveOnce)
+{
+    ::checkFish<SwordfishSolver<SRSudoku9x9>, SRSudoku9x9>({ 0, 4, 8 }, { 1, 4, 7 }, 5, true);
+    ::checkFish<JellyfishSolver<SRSudoku9x9>, SRSudoku9x9>({ 1, 2, 5, 6 }, { 0, 3, 7, 8 }, 9, false);
+}
+
+TEST(StaticRegularSudokuSolverTest, basicFishSolver_sizeOne)
+{
+    // A line with a single candidate for the value removes it from the crossing line
+    ::checkFish<BasicFishSolver<1, SRSudoku9x9>, SRSudoku9x9>({ 3 }, { 6 }, 4, true);
+    ::checkFish<BasicFishSolver<1, SRSudoku9x9>, SRSudoku9x9>({ 7 }, { 0 }, 2, false);
+}
+
+TEST(StaticRegularSudokuSolverTest, basicFishSolver_largeFish)
+{
+    ::checkFish<BasicFishSolver<5, SRSudoku16x16>, SRSudoku16x16>({ 0, 2, 5, 9, 14 }, { 1, 3, 6, 10, 12 }, 3, false);
+    ::checkFish<BasicFishSolver<7, SRSudoku16x16>, SRSudoku16x16>({ 1, 2, 3, 4, 8, 11, 15 }
+                                                                , { 0, 4, 5, 7, 9, 13, 14 }
+                                                                , 16
+                                                                , true);
+}
+
+TEST(StaticRegularSudokuSolverTest, finnedFishSolver_solveOnce)
+{
+    // Value 5 is left in row 1 at columns 2 and 7, and in row 5 at columns 2 and 7 plus a fin at column 8 (finned
+    // X-Wing), or at column 2 plus a fin at column 8 (sashimi X-Wing)
+    for (std::size_t const rowFiveSeven : { 1, 0 })
+    {
+        SudokuDescriptor<SRSudoku9x9> descriptor{ SRSudoku9x9{} };
+        for (std::size_t x = 0; x < SRSudoku9x9::columnCount; ++x)
+        {
+            if ((x != 2) && (x != 7))
+            {
+                descriptor.possibilities().reset(descriptor.bitIndex(SRSudoku9x9::coordinatesToCell(x, 1), 5));
+            }
+
+            if ((x != 2) && (x != 8) && ((x != 7) || (rowFiveSeven == 0)))
+            {
+                descriptor.possibilities().reset(descriptor.bitIndex(SRSudoku9x9::coordinatesToCell(x, 5), 5));
+            }
+        }
+
+        SudokuDescriptor<SRSudoku9x9> const startDescriptor{ descriptor };
+        ASSERT_FALSE(XWingSolver<SRSudoku9x9>{}.solveOnce(descriptor));
+        ASSERT_TRUE(FinnedXWingSolver<SRSudoku9x9>{}.solveOnce(descriptor));
+
+        // Only the cells of column 7 in the fin's box lose 5, and for the sashimi X-Wing also the cells of column 8
+        // in the box of (7, 1), which is the fin of the sashimi X-Wing over columns 2 and 8
+        auto expected = startDescriptor.possibilities();
+        expected.reset(descriptor.bitIndex(SRSudoku9x9::coordinatesToCell(7, 3), 5));
+        expected.reset(descriptor.bitIndex(SRSudoku9x9::coordinatesToCell(7, 4), 5));
+        if (rowFiveSeven == 0)
+        {
+            expected.reset(descriptor.bitIndex(SRSudoku9x9::coordinatesToCell(8, 0), 5));
+            expected.reset(descriptor.bitIndex(SRSudoku9x9::coordinatesToCell(8, 2), 5));
+        }
+        ASSERT_EQ(descriptor.possibilities(), expected);
+    }
+}
+
+TEST(StaticRegularSudokuSolverTest, frankenFishSolver_solveOnce)
+{
+    // Value 4 is left in row 0 at columns 1 and 4, and in box 4 at (4, 3) and (4, 5): columns 1 and 4 cover both
+    SudokuDescriptor<SRSudoku9x9> descriptor{ SRSudoku9x9{} };
+    for (std::size_t x = 0; x < SRSudoku9x9::columnCount; ++x)
+    {
+        if ((x != 1) && (x != 4))
+        {
+            descriptor.possibilities().reset(descriptor.bitIndex(SRSudoku9x9::coordinatesToCell(x, 0), 4));
+        }
+    }
+    for (std::size_t cell : { 30, 32, 39, 40, 41, 48, 50 })
+    {
+        descriptor.possibilities().reset(descriptor.bitIndex(cell, 4));
+    }
+
+    FinnedXWingSolver<SRSudoku9x9> finnedSolver;
+    FrankenFishSolver<2, SRSudoku9x9> frankenSolver;
+
+    SudokuDescriptor<SRSudoku9x9> const startDescriptor{ descriptor };
+    ASSERT_FALSE(finnedSolver.solveOnce(descriptor));
+    ASSERT_TRUE(frankenSolver.solveOnce(descriptor));
+
+    // 4 is gone from columns 1 and 4, and from box 0 covering (1, 0) along with column 4, but for the cells where it
+    // can still be. (4, 0) goes too: box 4 and row 0 can't both have their 4 in column 4.
+    for (std::size_t cell = 0; cell < SRSudoku9x9::cellCount; ++cell)
+    {
+        auto const x = SRSudoku9x9::cellToX(cell);
+        bool const isBaseCell = (cell == 1) || (cell == 31) || (cell == 49);
+        bool const isCoverCell = (x == 1) || (x == 4) || (SRSudoku9x9::cellToBoxIndex(cell) == 0);
+        bool const expected = startDescriptor.possibilities().test(descriptor.bitIndex(cell, 4))
+                           && (isBaseCell || !isCoverCell);
+        ASSERT_EQ(descriptor.possibilities().test(descriptor.bitIndex(cell, 4)), expected);
+    }
+}
+
+TEST(StaticRegularSudokuSolverTest, solverPipeline_cheapestFirst)
+{
+    SolverPipeline<SRSudoku9x9> pipeline;
+    pipeline.add<NakedSingleSolver<SRSudoku9x9>>();
+    pipeline.add<HiddenSingleSolver<SRSudoku9x9>>();
+    SudokuDescriptor<SRSudoku9x9> descriptor{ ::pureNakedSingleSolvable };
+
+    auto const report = pipeline.solve(descriptor);
+    ASSERT_TRUE(report.filled);
+    ASSERT_TRUE(SRSudoku9x9{ descriptor }.isSolved());
+
+    // Naked singles were enough, hidden singles never had to run
+    ASSERT_EQ(report.applicationCounts.size(), 2);
+    ASSERT_GT(report.applicationCounts[0], 0);
+    ASSERT_EQ(report.applicationCounts[1], 0);
+}
+
+TEST(StaticRegularSudokuSolverTest, solverPipeline_fixpoint)
+{
+    SolverPipeline<SRSudoku9x9> pipeline;
+    pipeline.add<NakedSingleSolver<SRSudoku9x9>>();
+    pipeline.add<HiddenSingleSolver<SRSudoku9x9>>();
+    SudokuDescriptor<SRSudoku9x9> descriptor{ ::hiddenSingleFirstStep };
+
+    auto const report = pipeline.solve(descriptor);
+    ASSERT_TRUE(report.filled);
+    ASSERT_GT(report.applicationCounts[0], 0);
+    ASSERT_GT(report.applicationCounts[1], 0);
+
+    SRSudoku9x9 const resultGrid = descriptor;
+    ASSERT_TRUE(resultGrid.isSolved());
+
+    auto const [mismatchIt, _] = std::ranges::mismatch(resultGrid
+                                                     , ::hiddenSingleFirstStep
+                                                     , [](auto value, auto model)
+                                                       {
+                                                           return (model == 0) || (value == model);
+                                                       }
+    );
+
+    // Nothing has been changed that shouldn't have been
+    ASSERT_EQ(mismatchIt, resultGrid.end());
+
+    // Running again on a filled grid is a no-op
+    ASSERT_FALSE(pipeline.solveOnce(descriptor));
+}
+
+TEST(StaticRegularSudokuSolverTest, solverPipeline_stdBitsetDescriptor)
+{
+    using StdBitsetDescriptor = SudokuDescriptor<SRSudoku9x9, std::bitset>;
+
+    SolverPipeline<SRSudoku9x9, StdBitsetDescriptor> pipeline;
+    pipeline.add<NakedSingleSolver<SRSudoku9x9, StdBitsetDescriptor>>();
+    pipeline.add<HiddenSingleSolver<SRSudoku9x9, StdBitsetDescriptor>>();
+    pipeline.add<LockedCandidatesSolver<SRSudoku9x9, StdBitsetDescriptor>>();
+    StdBitsetDescriptor descriptor{ ::hiddenSingleFirstStep };
+
+    SolverPipeline<SRSudoku9x9> defaultPipeline;
+    defaultPipeline.add<NakedSingleSolver<SRSudoku9x9>>();
+    defaultPipeline.add<HiddenSingleSolver<SRSudoku9x9>>();
+    defaultPipeline.add<LockedCandidatesSolver<SRSudoku9x9>>();
+    SudokuDescriptor<SRSudoku9x9> defaultDescriptor{ ::hiddenSingleFirstStep };
+
+    // Bitset implementations are interchangeable
+    auto const report = pipeline.solve(descriptor);
+    auto const defaultReport = defaultPipeline.solve(defaultDescriptor);
+    ASSERT_TRUE(report.filled);
+    ASSERT_EQ(report.applicationCounts, defaultReport.applicationCounts);
+
+    SRSudoku9x9 const resultGrid = descriptor;
+    SRSudoku9x9 const defaultResultGrid = defaultDescriptor;
+    auto const [mismatchIt, _] = std::ranges::mismatch(resultGrid, defaultResultGrid);
+    ASSERT_EQ(mismatchIt, resultGrid.end());
+}
+
+TEST(StaticRegularSudokuSolverTest, solverPipeline_valueMajorDescriptor)
+{
+    using ValueMajorDescriptor = SudokuDescriptor<SRSudoku9x9, StaticBitset, ValueMajorLayout>;
+
+    SolverPipeline<SRSudoku9x9, ValueMajorDescriptor> pipeline;
+    pipeline.add<NakedSingleSolver<SRSudoku9x9, ValueMajorDescriptor>>();
+    pipeline.add<HiddenSingleSolver<SRSudoku9x9, ValueMajorDescriptor>>();
+    pipeline.add<LockedCandidatesSolver<SRSudoku9x9, ValueMajorDescriptor>>();
+    pipeline.add<HiddenTupleSolver<2, SRSudoku9x9, ValueMajorDescriptor>>();
+    pipeline.add<XWingSolver<SRSudoku9x9, ValueMajorDescriptor>>();
+    pipeline.add<BacktrackingSolver<SRSudoku9x9, ValueMajorDescriptor>>();
+
+    ValueMajorDescriptor descriptor{ ::logicResistant };
+    ASSERT_TRUE(pipeline.solve(descriptor).filled);
+
+    SRSudoku9x9 const resultGrid = descriptor;
+    auto const [mismatchIt, _] = std::ranges::mismatch(resultGrid, ::logicResistantSolution);
+    ASSERT_EQ(mismatchIt, resultGrid.end());
+}
+
+TEST(StaticRegularSudokuSolverTest, solverPipeline_compactDescriptor)
+{
+    using CompactDescriptor = CompactSudokuDescriptor<SRSudoku9x9>;
+
+    SolverPipeline<SRSudoku9x9, CompactDescriptor> pipeline;
+    pipeline.add<NakedSingleSolver<SRSudoku9x9, CompactDescriptor>>();
+    pipeline.add<HiddenSingleSolver<SRSudoku9x9, CompactDescriptor>>();
+
+    for (auto const& grid : { ::pureNakedSingleSolvable, ::hiddenSingleFirstStep })
+    {
+        CompactDescriptor descriptor{ grid };
+        ASSERT_TRUE(pipeline.solve(descriptor).filled);
+
+        SRSudoku9x9 const resultGrid = descriptor;
+        ASSERT_TRUE(resultGrid.isSolved());
+
+        auto const [mismatchIt, _] = std::ranges::mismatch(resultGrid
+                                                         , grid
+                                                         , [](auto value, auto model)
+                                                           {
+                                                               return (model == 0) || (value == model);
+                                                           }
+        );
+        ASSERT_EQ(mismatchIt, resultGrid.end());
+    }
+}
+
+TEST(StaticRegularSudokuSolverTest, nakedSingleSolver_compactDescriptorMatchesBitsets)
+{
+    NakedSingleSolver<SRSudoku9x9> solver;
+    NakedSingleSolver<SRSudoku9x9, CompactSudokuDescriptor<SRSudoku9x9>> compactSolver;
+
+    SudokuDescriptor<SRSudoku9x9> descriptor{ ::pureNakedSingleSolvable };
+    CompactSudokuDescriptor<SRSudoku9x9> compactDescriptor{ descriptor };
+
+    // Both find the same naked singles, step by step
+    while (solver.solveOnce(descriptor))
+    {
+        ASSERT_TRUE(compactSolver.solveOnce(compactDescriptor));
+
+        auto const converted = compactDescriptor.toDescriptor<SudokuDescriptor<SRSudoku9x9>>();
+        ASSERT_EQ(converted.possibilities(), descriptor.possibilities());
+        ASSERT_EQ(converted.missingValuesMask(), descriptor.missingValuesMask());
+    }
+
+    ASSERT_FALSE(compactSolver.solveOnce(compactDescriptor));
+    ASSERT_TRUE(compactDescriptor.isFilled());
+}
+
+TEST(StaticRegularSudokuSolverTest, solverPipeline_stuck)
+{
+    SolverPipeline<SRSudoku9x9> pipeline;
+    pipeline.add<NakedSingleSolver<SRSudoku9x9>>();
+    SudokuDescriptor<SRSudoku9x9> descriptor{ ::hiddenSingleFirstStep };
+
+    // Only hidden singles are available, so naked singles alone cannot progress
+    auto const report = pipeline.solve(descriptor);
+    ASSERT_FALSE(report.filled);
+    ASSERT_FALSE(report.hasProgressed());
+}
+
+TEST(StaticRegularSudokuSolverTest, backtrackingSolver_solveOnce)
+{
+    BacktrackingSolver<SRSudoku9x9> solver;
+    SudokuDescriptor<SRSudoku9x9> descriptor{ ::logicResistant };
+
+    {
+        SolverPipeline<SRSudoku9x9> pipeline;
+        pipeline.add<NakedSingleSolver<SRSudoku9x9>>();
+        pipeline.add<HiddenSingleSolver<SRSudoku9x9>>();
+
+        // Singles alone cannot solve it
+        ASSERT_FALSE(pipeline.solve(descriptor).filled);
+    }
+
+    ASSERT_TRUE(solver.solveOnce(descriptor));
+    ASSERT_TRUE(descriptor.isFilled());
+
+    SRSudoku9x9 const resultGrid = descriptor;
+    auto const [mismatchIt, _] = std::ranges::mismatch(resultGrid, ::logicResistantSolution);
+    ASSERT_EQ(mismatchIt, resultGrid.end());
+
+    // Nothing left to guess
+    ASSERT_FALSE(solver.solveOnce(descriptor));
+}
+
+TEST(StaticRegularSudokuSolverTest, backtrackingSolver_noSolution)
+{
+    BacktrackingSolver<SRSudoku9x9> solver;
+    SudokuDescriptor<SRSudoku9x9> const startDescriptor{ ::noSolution };
+    SudokuDescriptor<SRSudoku9x9> descriptor{ startDescriptor };
+
+    ASSERT_FALSE(solver.solveOnce(descriptor));
+
+    // Descriptor is left untouched
+    ASSERT_EQ(descriptor.possibilities(), startDescriptor.possibilities());
+    ASSERT_EQ(descriptor.missingValuesMask(), startDescriptor.missingValuesMask());
+}
+
+TEST(StaticRegularSudokuSolverTest, backtrackingSolver_trailedDescriptor)
+{
+    using Descriptor = TrailedSudokuDescriptor<SRSudoku9x9>;
+    BacktrackingSolver<SRSudoku9x9, Descriptor> solver;
+
+    Descriptor descriptor{ ::logicResistant };
+    ASSERT_TRUE(solver.solveOnce(descriptor));
+    ASSERT_TRUE(descriptor.isFilled());
+
+    SRSudoku9x9 const resultGrid = descriptor;
+    auto const [mismatchIt, _] = std::ranges::mismatch(resultGrid, ::logicResistantSolution);
+    ASSERT_EQ(mismatchIt, resultGrid.end());
+
+    // Guesses leading nowhere are rolled back, and the descriptor is left untouched
+    Descriptor const startDescriptor{ ::noSolution };
+    Descriptor noSolutionDescriptor{ startDescriptor };
+    ASSERT_FALSE(solver.solveOnce(noSolutionDescriptor));
+    ASSERT_EQ(noSolutionDescriptor.possibilities(), startDescriptor.possibilities());
+    ASSERT_EQ(noSolutionDescriptor.missingValuesMask(), startDescriptor.missingValuesMask());
+}
+
+TEST(StaticRegularSudokuSolverTest, backtrackingSolver_customPropagation)
+{
+    SolverPipeline<SRSudoku9x9> propagator;
+    propagator.add<NakedSingleSolver<SRSudoku9x9>>();
+    propagator.add<HiddenSingleSolver<SRSudoku9x9>>();
+    propagator.add<LockedCandidatesSolver<SRSudoku9x9>>();
+
+    SolverPipeline<SRSudoku9x9> pipeline;
+    pipeline.add<NakedSingleSolver<SRSudoku9x9>>();
+    pipeline.add<HiddenSingleSolver<SRSudoku9x9>>();
+    pipeline.add<BacktrackingSolver<SRSudoku9x9>>(propagator);
+
+    SudokuDescriptor<SRSudoku9x9> descriptor{ ::logicResistant };
+    auto const report = pipeline.solve(descriptor);
+    ASSERT_TRUE(report.filled);
+    ASSERT_EQ(report.applicationCounts[2], 1);
+
+    SRSudoku9x9 const resultGrid = descriptor;
+    auto const [mismatchIt, _] = std::ranges::mismatch(resultGrid, ::logicResistantSolution);
+    ASSERT_EQ(mismatchIt, resultGrid.end());
+}
+
+TEST(StaticRegularSudokuSolverTest, dancingLinksSolver_solveOnce)
+{
+    DancingLinksSolver<SRSudoku9x9> solver;
+
+    SudokuDescriptor<SRSudoku9x9> descriptor{ ::logicResistant };
+    ASSERT_TRUE(solver.solveOnce(descriptor));
+    ASSERT_TRUE(descriptor.isFilled());
+
+    SRSudoku9x9 const resultGrid = descriptor;
+    auto const [mismatchIt, _] = std::ranges::mismatch(resultGrid, ::logicResistantSolution);
+    ASSERT_EQ(mismatchIt, resultGrid.end());
+
+    // Nothing left to do
+    ASSERT_FALSE(solver.solveOnce(descriptor));
+
+    // Without a solution, the descriptor is left as it was
+    SudokuDescriptor<SRSudoku9x9> const noSolutionDescriptor{ ::noSolution };
+    SudokuDescriptor<SRSudoku9x9> unsolvable{ noSolutionDescriptor };
+    ASSERT_FALSE(solver.solveOnce(unsolvable));
+    ASSERT_EQ(unsolvable.possibilities(), noSolutionDescriptor.possibilities());
+
+    // Large grids, from scratch
+    DancingLinksSolver<SRSudoku16x16> largeSolver;
+    SudokuDescriptor<SRSudoku16x16> largeDescriptor{ SRSudoku16x16{} };
+    ASSERT_TRUE(largeSolver.solveOnce(largeDescriptor));
+    ASSERT_TRUE(SRSudoku16x16{ largeDescriptor }.isSolved());
+}
+
+TEST(StaticRegularSudokuSolverTest, dancingLinksSolver_countSolutions)
+{
+    using Solver = DancingLinksSolver<SRSudoku9x9>;
+
+    ASSERT_EQ(Solver::countSolutions(SudokuDescriptor<SRSudoku9x9>{ ::logicResistant }, 2), 1);
+    ASSERT_EQ(Solver::countSolutions(SudokuDescriptor<SRSudoku9x9>{ ::noSolution }, 2), 0);
+    ASSERT_EQ(Solver::countSolutions(SudokuDescriptor<SRSudoku9x9>{ SRSudoku9x9{} }, 3), 3);
+
+    // Candidates removed by strategies are left out of the matrix
+    SudokuDescriptor<SRSudoku9x9> descriptor{ ::logicResistant };
+    descriptor.possibilities().reset(descriptor.bitIndex(1, *(::logicResistantSolution.begin() + 1)));
+    ASSERT_EQ(Solver::countSolutions(descriptor, 2), 0);
+}
+
+TEST(StaticRegularSudokuSolverTest, countSolutions)
+{
+    ASSERT_EQ(countSolutions(::logicResistant, 2), 1);
+    ASSERT_EQ(countSolutions(::logicResistantSolution, 2), 1);
+    ASSERT_EQ(countSolutions(::noSolution, 2), 0);
+    ASSERT_EQ(countSolutions(SRSudoku9x9{}, 5), 5);
+    ASSERT_EQ(countSolutions(::logicResistant, 0), 0);
+
+    ASSERT_TRUE(hasUniqueSolution(::logicResistant));
+    ASSERT_FALSE(hasUniqueSolution(::noSolution));
+    ASSERT_FALSE(hasUniqueSolution(SRSudoku9x9{}));
+
+    // Clashing givens
+    SRSudoku9x9 clashing = ::logicResistantSolution;
+    *(clashing.begin() + 1) = *clashing.begin();
+    ASSERT_EQ(countSolutions(clashing, 2), 0);
+
+    // Emptying the four corners of a rectangle whose cells hold two values in a row, a column and two boxes leaves
+    // two ways of placing them
+    SolutionCounter<SRSudoku9x9> counter;
+    SRSudoku9x9 solution = ::logicResistantSolution;
+    bool foundRectangle = false;
+    for (std::size_t y = 0; (y < 9) && !foundRectangle; ++y)
+    {
+        for (std::size_t x = 0; (x < 3) && !foundRectangle; ++x)
+        {
+            for (std::size_t otherX = 3; (otherX < 9) && !foundRectangle; ++otherX)
+            {
+                std::size_t const otherY = (y % 3 == 2) ? y - 1 : y + 1;
+                auto const at = [&](std::size_t cellX, std::size_t cellY)
+                {
+                    return solution.begin() + static_cast<std::ptrdiff_t>(solution.coordinatesToCell(cellX, cellY));
+                };
+
+                if ((*at(x, y) != *at(otherX, otherY)) || (*at(otherX, y) != *at(x, otherY)))
+                {
+                    continue;
+                }
+
+                for (auto [cellX, cellY] : { std::pair{ x, y }, { otherX, y }, { x, otherY }, { otherX, otherY } })
+                {
+                    *at(cellX, cellY) = 0;
+                }
+                foundRectangle = true;
+            }
+        }
+    }
+    ASSERT_TRUE(foundRectangle);
+    ASSERT_EQ(counter.count(solution, 5), 2);
+    ASSERT_FALSE(counter.hasUniqueSolution(solution));
+
+    // The descriptor is left as far as logic gets
+    SudokuDescriptor<SRSudoku9x9> descriptor{ ::logicResistant };
+    ASSERT_EQ(counter.countPropagated(descriptor, 2), 1);
+    ASSERT_FALSE(descriptor.isFilled());
+    ASSERT_EQ(DancingLinksSolver<SRSudoku9x9>::countSolutions(descriptor, 2), 1);
+}
+
+TEST(StaticRegularSudokuSolverTest, batchSolver_matchesScalarPipeline)
+{
+    std::array const puzzles{ ::pureNakedSingleSolvable
+                            , ::hiddenSingleFirstStep
+                            , ::hiddenPairExample
+                            , ::xWingExample
+                            , ::logicResistant };
+
+    std::array<SudokuDescriptor<SRSudoku9x9>, puzzles.size()> expected;
+    for (std::size_t i = 0; i < puzzles.size(); ++i)
+    {
+        SolverPipeline<SRSudoku9x9> pipeline;
+        pipeline.add<NakedSingleSolver<SRSudoku9x9>>();
+        pipeline.add<HiddenSingleSolver<SRSudoku9x9>>();
+        pipeline.add<LockedCandidatesSolver<SRSudoku9x9>>();
+
+        expected[i] = SudokuDescriptor<SRSudoku9x9>{ puzzles[i] };
+        pipeline.solve(expected[i]);
+    }
+
+    auto const checkBatch = [&](auto const& solver)
+    {
+        std::array<SudokuDescriptor<SRSudoku9x9>, puzzles.size()> results;
+        solver.solve(std::span<SRSudoku9x9 const>{ puzzles }, std::span<SudokuDescriptor<SRSudoku9x9>>{ results });
+
+        for (std::size_t i = 0; i < puzzles.size(); ++i)
+        {
+            ASSERT_EQ(results[i].possibilities(), expected[i].possibilities());
+            ASSERT_EQ(results[i].missingValuesMask(), expected[i].missingValuesMask());
+        }
+    };
+
+    // Fewer lanes than puzzles, so lanes get retired and refilled
+    checkBatch(BatchSolver<SRSudoku9x9, 2>{});
+
+    // More lanes than puzzles, so some lanes stay empty throughout
+    checkBatch(BatchSolver<SRSudoku9x9>{});
+}
+
+TEST(StaticRegularSudokuSolverTest, batchSolver_propagate)
+{
+    BatchDescriptor<SRSudoku9x9, 4> descriptor;
+    descriptor.load(0, SudokuDescriptor<SRSudoku9x9>{ ::hiddenSingleFirstStep });
+    descriptor.load(2, SudokuDescriptor<SRSudoku9x9>{ ::logicResistant });
+
+    BatchSolver<SRSudoku9x9, 4>{}.propagate(descriptor);
+    ASSERT_TRUE(descriptor.isFilled(0));
+    ASSERT_FALSE(descriptor.isFilled(2));
+
+    SRSudoku9x9 const resultGrid = descriptor.store(0);
+    ASSERT_TRUE(resultGrid.isSolved());
+
+    // Empty lanes stay empty
+    ASSERT_TRUE(descriptor.isFilled(1));
+    ASSERT_TRUE(descriptor.store(3).possibilities().none());
+}
+
+TEST(StaticRegularSudokuSolverTest, solveBatch_preservesOrder)
+{
+    std::array const samples{ ::pureNakedSingleSolvable
+                            , ::hiddenSingleFirstStep
+                            , ::hiddenPairExample
+                            , ::xWingExample };
+
+    std::vector<SRSudoku9x9> puzzles;
+    for (std::size_t i = 0; i < 60; ++i)
+    {
+        puzzles.push_back(samples[(i * 7) % samples.size()]);
+    }
+
+    // One puzzle much harder than the others
+    puzzles[17] = ::logicResistant;
+
+    for (std::size_t threadCount : { 1, 4, 0 })
+    {
+        std::vector<SRSudoku9x9> solutions(puzzles.size());
+        auto const filledCount = solveBatch<SRSudoku9x9>(puzzles, solutions, { .threadCount = threadCount });
+        ASSERT_EQ(filledCount, puzzles.size());
+
+        for (std::size_t i = 0; i < puzzles.size(); ++i)
+        {
+            ASSERT_TRUE(solutions[i].isSolved());
+
+            auto const [mismatchIt, _] = std::ranges::mismatch(solutions[i]
+                                                             , puzzles[i]
+                                                             , [](auto value, auto model)
+                                                               {
+                                                                   return (model == 0) || (value == model);
+                                                               }
+            );
+            ASSERT_EQ(mismatchIt, solutions[i].end());
+        }
+    }
+}
+
+TEST(StaticRegularSudokuSolverTest, solveBatch_customSolver)
+{
+    std::array const puzzles{ ::hiddenSingleFirstStep, ::logicResistant, ::pureNakedSingleSolvable };
+    std::array<SRSudoku9x9, puzzles.size()> solutions{};
+
+    // Naked singles alone only solve the last one, the others are returned partially filled
+    auto const filledCount = solveBatch<SRSudoku9x9>(std::span<SRSudoku9x9 const>{ puzzles }
+                                                   , std::span<SRSudoku9x9>{ solutions }
+                                                   , { .threadCount = 2 }
+                                                   , []
+                                                     {
+                                                         return std::make_unique<NakedSingleSolver<SRSudoku9x9>>();
+                                                     });
+    ASSERT_EQ(filledCount, 1);
+    ASSERT_FALSE(solutions[0].isSolved());
+    ASSERT_FALSE(solutions[1].isSolved());
+    ASSERT_TRUE(solutions[2].isSolved());
+}
+
+TEST(StaticRegularSudokuSolverTest, solveBatch_rethrowsWorkerException)
+{
+    std::vector<SRSudoku9x9> const puzzles(40, ::logicResistant);
+    std::vector<SRSudoku9x9> solutions(puzzles.size());
+
+    // Whichever worker gets the second solver throws, and it may or may not be the calling thread
+    std::atomic<std::size_t> solverCount = 0;
+    auto const makeSolver = [&]() -> std::unique_ptr<AbstractSolver<SRSudoku9x9>>
+    {
+        if (solverCount++ == 1)
+        {
+            throw std::runtime_error{ "no solver" };
+        }
+        return std::make_unique<BacktrackingSolver<SRSudoku9x9>>();
+    };
+
+    ASSERT_THROW(solveBatch<SRSudoku9x9>(std::span<SRSudoku9x9 const>{ puzzles }
+                                       , std::span<SRSudoku9x9>{ solutions }
+                                       , { .threadCount = 2 }
+                                       , makeSolver)
+               , std::runtime_error);
+    ASSERT_EQ(solverCount, 2);
+}
+
+TEST(StaticRegularSudokuSolverTest, difficultyGrader_grade)
+{
+    DifficultyGrader<SRSudoku9x9> grader;
+
+    Grade const nakedSingles = grader.grade(::pureNakedSingleSolvable);
+    ASSERT_EQ(nakedSingles.hardest, Technique::NakedSingle);
+    ASSERT_GT(nakedSingles.applicationCount(Technique::NakedSingle), 0);
+    ASSERT_FALSE(nakedSingles.guessed);
+    ASSERT_TRUE(nakedSingles.solved);
+
+    // Hidden singles are only counted once naked singles are stuck
+    Grade const hiddenSingles = grader.grade(::hiddenSingleFirstStep);
+    ASSERT_TRUE(hiddenSingles.hardest.has_value());
+    ASSERT_GE(*hiddenSingles.hardest, Technique::HiddenSingle);
+    ASSERT_GT(hiddenSingles.applicationCount(Technique::HiddenSingle), 0);
+
+    // Nothing cheaper than a guess solves it
+    SudokuDescriptor<SRSudoku9x9> descriptor{ ::logicResistant };
+    Grade const guessed = grader.grade(descriptor);
+    ASSERT_TRUE(guessed.guessed);
+    ASSERT_TRUE(guessed.solved);
+    SRSudoku9x9 const resultGrid = descriptor;
+    auto const [mismatchIt, _] = std::ranges::mismatch(resultGrid, ::logicResistantSolution);
+    ASSERT_EQ(mismatchIt, resultGrid.end());
+
+    Grade const unsolvable = grader.grade(::noSolution);
+    ASSERT_FALSE(unsolvable.solved);
+
+    // Already solved
+    Grade const solved = grader.grade(::logicResistantSolution);
+    ASSERT_FALSE(solved.hardest.has_value());
+    ASSERT_FALSE(solved.guessed);
+    ASSERT_TRUE(solved.solved);
+
+    ASSERT_EQ(techniqueName(Technique::FinnedSwordfish), "finned-swordfish");
+}
+
+TEST(StaticRegularSudokuSolverTest, difficultyGrader_gradeBatch)
+{
+    std::array const puzzles{ ::pureNakedSingleSolvable
+                            , ::hiddenSingleFirstStep
+                            , ::hiddenPairExample
+                            , ::xWingExample
+                            , ::logicResistant
+                            , ::noSolution };
+
+    std::array<Grade, puzzles.size()> grades;
+    gradeBatch(std::span<SRSudoku9x9 const>{ puzzles }, std::span<Grade>{ grades }, BatchOptions{ .threadCount = 2 });
+
+    DifficultyGrader<SRSudoku9x9> grader;
+    for (std::size_t i = 0; i < puzzles.size(); ++i)
+    {
+        Grade const expected = grader.grade(puzzles[i]);
+        ASSERT_EQ(grades[i].applicationCounts, expected.applicationCounts);
+        ASSERT_EQ(grades[i].hardest, expected.hardest);
+        ASSERT_EQ(grades[i].guessed, expected.guessed);
+        ASSERT_EQ(grades[i].solved, expected.solved);
+    }
+}
+
+TEST(StaticRegularSudokuSolverTest, strategyChain_matchesPipeline)
+{
+    SolverPipeline<SRSudoku9x9> pipeline;
+    pipeline.add<NakedSingleSolver<SRSudoku9x9>>();
+    pipeline.add<HiddenSingleSolver<SRSudoku9x9>>();
+    pipeline.add<LockedCandidatesSolver<SRSudoku9x9>>();
+
+    StrategyChain<NakedSingleSolver<SRSudoku9x9>
+                , HiddenSingleSolver<SRSudoku9x9>
+                , LockedCandidatesSolver<SRSudoku9x9>> chain;
+
+    for (auto const& grid : { ::pureNakedSingleSolvable, ::hiddenSingleFirstStep, ::hiddenPairExample })
+    {
+        SudokuDescriptor<SRSudoku9x9> pipelineDescriptor{ grid };
+        SudokuDescriptor<SRSudoku9x9> chainDescriptor{ grid };
+
+        auto const pipelineReport = pipeline.solve(pipelineDescriptor);
+        auto const chainReport = chain.solve(chainDescriptor);
+
+        ASSERT_EQ(chainReport.filled, pipelineReport.filled);
+        ASSERT_TRUE(std::ranges::equal(chainReport.applicationCounts, pipelineReport.applicationCounts));
+        ASSERT_EQ(chainDescriptor.possibilities(), pipelineDescriptor.possibilities());
+        ASSERT_EQ(chainDescriptor.missingValuesMask(), pipelineDescriptor.missingValuesMask());
+    }
+}
+
+TEST(StaticRegularSudokuSolverTest, solverPipeline_changedOnly)
+{
+    // The pipeline hands strategies what changed since they last ran, the chain always runs them in full
+    SolverPipeline<SRSudoku9x9> pipeline;
+    pipeline.add<NakedSingleSolver<SRSudoku9x9>>();
+    pipeline.add<HiddenSingleSolver<SRSudoku9x9>>();
+    pipeline.add<LockedCandidatesSolver<SRSudoku9x9>>();
+    pipeline.add<NakedTupleSolver<2, SRSudoku9x9>>();
+    pipeline.add<HiddenTupleSolver<2, SRSudoku9x9>>();
+    pipeline.add<XWingSolver<SRSudoku9x9>>();
+    pipeline.add<FinnedSwordfishSolver<SRSudoku9x9>>();
+
+    StrategyChain<NakedSingleSolver<SRSudoku9x9>
+                , HiddenSingleSolver<SRSudoku9x9>
+                , LockedCandidatesSolver<SRSudoku9x9>
+                , NakedTupleSolver<2, SRSudoku9x9>
+                , HiddenTupleSolver<2, SRSudoku9x9>
+                , XWingSolver<SRSudoku9x9>
+                , FinnedSwordfishSolver<SRSudoku9x9>> chain;
+
+    for (auto const& grid : { ::hiddenPairExample, ::xWingExample, ::logicResistant })
+    {
+        SudokuDescriptor<SRSudoku9x9> pipelineDescriptor{ grid };
+        SudokuDescriptor<SRSudoku9x9> chainDescriptor{ grid };
+
+        // A pass over the changes may leave for the next pass what a full pass finds later on in the same pass, so
+        // strategies may progress in a different number of steps, but towards the same fixpoint
+        pipeline.solve(pipelineDescriptor);
+        chain.solve(chainDescriptor);
+
+        ASSERT_EQ(chainDescriptor.possibilities(), pipelineDescriptor.possibilities());
+        ASSERT_EQ(chainDescriptor.missingValuesMask(), pipelineDescriptor.missingValuesMask());
+    }
+
+    // Nothing changed, nothing to look at
+    SudokuDescriptor<SRSudoku9x9> descriptor{ ::hiddenPairExample };
+    HiddenTupleSolver<2, SRSudoku9x9> solver;
+    ASSERT_FALSE(solver.solveChanged(descriptor, {}));
+    ASSERT_TRUE(solver.solveChanged(descriptor, CandidateChanges<SRSudoku9x9>::everything()));
+
+    // Naked singles are only looked for in the changed cells
+    SudokuDescriptor<SRSudoku9x9> singles{ ::pureNakedSingleSolvable };
+    SudokuDescriptor<SRSudoku9x9> const startSingles{ singles };
+    NakedSingleSolver<SRSudoku9x9> singleSolver;
+    ASSERT_FALSE(singleSolver.solveChanged(singles, {}));
+    ASSERT_TRUE(singleSolver.solveChanged(singles, CandidateChanges<SRSudoku9x9>::everything()));
+
+    SudokuDescriptor<SRSudoku9x9> fullPass{ startSingles };
+    ASSERT_TRUE(singleSolver.solveOnce(fullPass));
+    ASSERT_EQ(singles.possibilities(), fullPass.possibilities());
+    ASSERT_EQ(singles.missingValuesMask(), fullPass.missingValuesMask());
+}
+
+TEST(StaticRegularSudokuSolverTest, strategyChain_asPropagator)
+{
+    StrategyChain<NakedSingleSolver<SRSudoku9x9>, HiddenSingleSolver<SRSudoku9x9>> propagator;
+    StrategyChain<NakedSingleSolver<SRSudoku9x9>
+                , HiddenSingleSolver<SRSudoku9x9>
+                , BacktrackingSolver<SRSudoku9x9>> chain{ {}, {}, BacktrackingSolver<SRSudoku9x9>{ propagator } };
+
+    SudokuDescriptor<SRSudoku9x9> descriptor{ ::logicResistant };
+    auto const report = chain.solve(descriptor);
+    ASSERT_TRUE(report.filled);
+    ASSERT_EQ(report.applicationCounts[2], 1);
+
+    SRSudoku9x9 const resultGrid = descriptor;
+    auto const [mismatchIt, _] = std::ranges::mismatch(resultGrid, ::logicResistantSolution);
+    ASSERT_EQ(mismatchIt, resultGrid.end());
+}
@@ -0,0 +1,467 @@
+// Copyright 2022 DrSinIsIn (axel.gaillard.dev@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Solves one puzzle per line from a file or stdin, writes the solutions and reports throughput on stderr:
+//   sudoku-solve [--strategies a,b,...] [--threads n] [--output file] [input file]
+// With --grade, writes the grade of each puzzle instead, as CSV.
+
+#include "IO/MappedFile.h"
+#include "IO/PuzzleFileReader.h"
+#include "IO/PuzzleFileWriter.h"
+#include "IO/PuzzleFormat.h"
+#include "Solvers/BacktrackingSolver.h"
+#include "Solvers/BasicFishSolver.h"
+#include "Solvers/BatchSolving.h"
+#include "Solvers/DancingLinksSolver.h"
+#include "Solvers/DifficultyGrading.h"
+#include "Solvers/FinnedFishSolver.h"
+#include "Solvers/HiddenTupleSolver.h"
+#include "Solvers/LockedCandidatesSolver.h"
+#include "Solvers/NakedSingleSolver.h"
+#include "Solvers/NakedTupleSolver.h"
+#include "Solvers/SolverPipeline.h"
+#include "Solvers/TimedSolver.h"
+#include "Sudoku.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <exception>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace
+{
+    constexpr std::string_view defaultStrategies
+        = "naked-single,hidden-single,locked-candidates,hidden-pair,x-wing,backtracking";
+
+    constexpr std::string_view backtrackingStrategy = "backtracking";
+    constexpr std::string_view dancingLinksStrategy = "dancing-links";
+
+    struct Options
+    {
+        std::vector<std::string> strategies;
+        std::size_t threadCount = 0;
+        std::optional<std::string> inputPath;
+        std::optional<std::string> outputPath;
+        bool grade = false;
+    };
+
+    std::vector<std::string> split(std::string_view list)
+    {
+        std::vector<std::string> result;
+        std::istringstream stream{ std::string{ list } };
+        for (std::string item; std::getline(stream, item, ',');)
+        {
+            if (!item.empty())
+            {
+                result.push_back(item);
+            }
+        }
+
+        return result;
+    }
+
+    void printUsage()
+    {
+        std::cerr << "Usage: sudoku-solve [--strategies a,b,...] [--grade] [--threads n] [--output file] [input file]\n"
+                  << "Reads stdin when no input file is given, writes to stdout when no output file is given.\n"
+                  << "Grid size is picked from the first puzzle's length (16, 36, 81, 256 or 625 cells).\n"
+                  << "Strategies, run cheapest first in the given order (default " << defaultStrategies << "):\n"
+                  << "  naked-single, hidden-single, naked-pair, naked-triple, hidden-pair, hidden-triple,\n"
+                  << "  locked-candidates, x-wing, swordfish, jellyfish, finned-x-wing, finned-swordfish,\n"
+                  << "  franken-x-wing, franken-swordfish, backtracking, dancing-links\n"
+                  << "--grade writes, instead of the solutions, one CSV line per puzzle: the hardest technique needed\n"
+                  << "(none if the puzzle was solved already), whether guessing was needed, whether the puzzle has a\n"
+                  << "solution, and how many times each technique made progress. Strategies are then ignored.\n";
+    }
+
+    std::optional<Options> parseArguments(int argc, char** argv)
+    {
+        Options options;
+        options.strategies = split(defaultStrategies);
+
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string_view const argument = argv[i];
+            bool const hasValue = (i + 1) < argc;
+
+            if ((argument == "--strategies") && hasValue)
+            {
+                options.strategies = split(argv[++i]);
+            }
+            else if (argument == "--grade")
+            {
+                options.grade = true;
+            }
+            else if ((argument == "--threads") && hasValue)
+            {
+                // 0 would mean every hardware thread, which is what leaving the option out does
+                std::string_view const value = argv[++i];
+                char const* const valueEnd = value.data() + value.size();
+                auto const [end, error] = std::from_chars(value.data(), valueEnd, options.threadCount);
+                if ((error != std::errc{}) || (end != valueEnd) || (options.threadCount == 0))
+                {
+                    std::cerr << "--threads expects a positive number, got '" << value << "'\n";
+                    return std::nullopt;
+                }
+            }
+            else if ((argument == "--output") && hasValue)
+            {
+                options.outputPath = argv[++i];
+            }
+            else if (!argument.starts_with("--") && !options.inputPath)
+            {
+                options.inputPath = argument;
+            }
+            else
+            {
+                return std::nullopt;
+            }
+        }
+
+        return options;
+    }
+
+    template<typename Grid>
+    using SolverPointer = std::unique_ptr<AbstractSolver<Grid>>;
+
+    // nullptr for unknown names and strategies not available at this grid size
+    template<typename Grid>
+    SolverPointer<Grid> makeStrategy(std::string_view name)
+    {
+        if (name == "naked-single")
+        {
+            return std::make_unique<NakedSingleSolver<Grid>>();
+        }
+        if (name == "hidden-single")
+        {
+            return std::make_unique<HiddenSingleSolver<Grid>>();
+        }
+        if (name == "locked-candidates")
+        {
+            return std::make_unique<LockedCandidatesSolver<Grid>>();
+        }
+        if (name == backtrackingStrategy)
+        {
+            return std::make_unique<BacktrackingSolver<Grid>>();
+        }
+        if (name == dancingLinksStrategy)
+        {
+            return std::make_unique<DancingLinksSolver<Grid>>();
+        }
+        if constexpr (requires { typename NakedPairSolver<Grid>; })
+        {
+            if (name == "naked-pair")
+            {
+                return std::make_unique<NakedPairSolver<Grid>>();
+            }
+        }
+        if constexpr (requires { typename NakedTripleSolver<Grid>; })
+        {
+            if (name == "naked-triple")
+            {
+                return std::make_unique<NakedTripleSolver<Grid>>();
+            }
+        }
+        if constexpr (requires { typename HiddenTupleSolver<2, Grid>; })
+        {
+            if (name == "hidden-pair")
+            {
+                return std::make_unique<HiddenTupleSolver<2, Grid>>();
+            }
+        }
+        if constexpr (requires { typename HiddenTupleSolver<3, Grid>; })
+        {
+            if (name == "hidden-triple")
+            {
+                return std::make_unique<HiddenTupleSolver<3, Grid>>();
+            }
+        }
+        if constexpr (requires { typename XWingSolver<Grid>; })
+        {
+            if (name == "x-wing")
+            {
+                return std::make_unique<XWingSolver<Grid>>();
+            }
+        }
+        if constexpr (requires { typename SwordfishSolver<Grid>; })
+        {
+            if (name == "swordfish")
+            {
+                return std::make_unique<SwordfishSolver<Grid>>();
+            }
+        }
+        if constexpr (requires { typename JellyfishSolver<Grid>; })
+        {
+            if (name == "jellyfish")
+            {
+                return std::make_unique<JellyfishSolver<Grid>>();
+            }
+        }
+        if constexpr (requires { typename FinnedXWingSolver<Grid>; })
+        {
+            if (name == "finned-x-wing")
+            {
+                return std::make_unique<FinnedXWingSolver<Grid>>();
+            }
+            if (name == "franken-x-wing")
+            {
+                return std::make_unique<FrankenFishSolver<2, Grid>>();
+            }
+        }
+        if constexpr (requires { typename FinnedSwordfishSolver<Grid>; })
+        {
+            if (name == "finned-swordfish")
+            {
+                return std::make_unique<FinnedSwordfishSolver<Grid>>();
+            }
+            if (name == "franken-swordfish")
+            {
+                return std::make_unique<FrankenFishSolver<3, Grid>>();
+            }
+        }
+
+        return nullptr;
+    }
+
+    // One pipeline per worker, all of them feeding the same statistics
+    template<typename Grid>
+    SolverPointer<Grid> makeTimedPipeline(std::vector<std::string> const& strategies
+                                        , std::vector<SolverStatistics>& statistics)
+    {
+        auto pipeline = std::make_unique<SolverPipeline<Grid>>();
+        for (std::size_t i = 0; i < strategies.size(); ++i)
+        {
+            pipeline->template add<TimedSolver<Grid>>(makeStrategy<Grid>(strategies[i]), statistics[i]);
+        }
+
+        return pipeline;
+    }
+
+    template<typename Grid>
+    int runGrading(std::string_view text, Options const& options)
+    {
+        std::vector<Grid> const puzzles = PuzzleFileReader<Grid>{ text }.readAll();
+        std::vector<Grade> grades(puzzles.size());
+
+        auto const start = std::chrono::steady_clock::now();
+        gradeBatch<Grid>(puzzles, grades, { .threadCount = options.threadCount });
+        std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+
+        std::FILE* const output = options.outputPath ? std::fopen(options.outputPath->c_str(), "w") : stdout;
+        if (!output)
+        {
+            std::cerr << "Cannot open " << *options.outputPath << '\n';
+            return 1;
+        }
+
+        std::string line = "hardest,guessed,solved";
+        for (std::size_t i = 0; i < techniqueCount; ++i)
+        {
+            line += ',';
+            line += techniqueName(static_cast<Technique>(i));
+        }
+        line += '\n';
+        std::fwrite(line.data(), 1, line.size(), output);
+
+        // Puzzles per hardest technique, the last slot counting the puzzles needing no technique
+        std::array<std::size_t, techniqueCount + 1> hardestCounts{};
+        std::size_t guessedCount = 0;
+        std::size_t solvedCount = 0;
+        for (auto const& grade : grades)
+        {
+            line = grade.hardest ? techniqueName(*grade.hardest) : "none";
+            line += grade.guessed ? ",1" : ",0";
+            line += grade.solved ? ",1" : ",0";
+            for (auto const count : grade.applicationCounts)
+            {
+                line += ',';
+                line += std::to_string(count);
+            }
+            line += '\n';
+            std::fwrite(line.data(), 1, line.size(), output);
+
+            ++hardestCounts[grade.hardest ? static_cast<std::size_t>(*grade.hardest) : techniqueCount];
+            guessedCount += grade.guessed ? 1 : 0;
+            solvedCount += grade.solved ? 1 : 0;
+        }
+
+        if (output != stdout)
+        {
+            std::fclose(output);
+        }
+
+        std::cerr << "puzzles:    " << puzzles.size() << " (" << Grid::maxValue << 'x' << Grid::maxValue << ")\n"
+                  << "solved:     " << solvedCount << '\n'
+                  << "guessed:    " << guessedCount << '\n'
+                  << "time:       " << elapsed.count() << " s\n"
+                  << "throughput: " << (static_cast<double>(puzzles.size()) / elapsed.count()) << " puzzles/s\n"
+                  << "puzzles per hardest technique:\n"
+                  << "  none: " << hardestCounts[techniqueCount] << '\n';
+
+        for (std::size_t i = 0; i < techniqueCount; ++i)
+        {
+            std::cerr << "  " << techniqueName(static_cast<Technique>(i)) << ": " << hardestCounts[i] << '\n';
+        }
+
+        return 0;
+    }
+
+    template<typename Grid>
+    int run(std::string_view text, Options const& options)
+    {
+        if (options.grade)
+        {
+            return runGrading<Grid>(text, options);
+        }
+
+        for (auto const& name : options.strategies)
+        {
+            if (!makeStrategy<Grid>(name))
+            {
+                std::cerr << "Unknown strategy, or not available for this grid size: " << name << '\n';
+                return 2;
+            }
+        }
+
+        std::vector<Grid> const puzzles = PuzzleFileReader<Grid>{ text }.readAll();
+        std::vector<Grid> solutions(puzzles.size());
+        std::vector<SolverStatistics> statistics(options.strategies.size());
+
+        auto const start = std::chrono::steady_clock::now();
+        std::size_t const filledCount = solveBatch<Grid>(puzzles
+                                                        , solutions
+                                                        , { .threadCount = options.threadCount }
+                                                        , [&]
+                                                          {
+                                                              return makeTimedPipeline<Grid>(options.strategies
+                                                                                           , statistics);
+                                                          });
+        std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+
+        // Search strategies only report progress when they fill the grid, so once per guessed puzzle
+        std::size_t guessedCount = 0;
+        for (std::size_t i = 0; i < options.strategies.size(); ++i)
+        {
+            if ((options.strategies[i] == backtrackingStrategy) || (options.strategies[i] == dancingLinksStrategy))
+            {
+                guessedCount += statistics[i].progressCount;
+            }
+        }
+
+        if (options.outputPath)
+        {
+            PuzzleFileWriter<Grid> writer{ *options.outputPath, solutions.size() };
+            for (std::size_t i = 0; i < solutions.size(); ++i)
+            {
+                writer.write(i, solutions[i]);
+            }
+        }
+        else
+        {
+            std::string line(Grid::cellCount + 1, '\n');
+            for (auto const& solution : solutions)
+            {
+                PuzzleAlphabet<Grid>::encode(solution, line.data());
+                std::fwrite(line.data(), 1, line.size(), stdout);
+            }
+        }
+
+        auto const percentage = [&puzzles](std::size_t count)
+        {
+            return puzzles.empty() ? 0. : (100. * static_cast<double>(count) / static_cast<double>(puzzles.size()));
+        };
+
+        std::cerr << "puzzles:         " << puzzles.size() << " (" << Grid::maxValue << 'x' << Grid::maxValue << ")\n"
+                  << "solved:          " << filledCount << " (" << percentage(filledCount) << "%)\n"
+                  << "solved by logic: " << (filledCount - guessedCount)
+                  << " (" << percentage(filledCount - guessedCount) << "%)\n"
+                  << "time:            " << elapsed.count() << " s\n"
+                  << "throughput:      " << (static_cast<double>(puzzles.size()) / elapsed.count()) << " puzzles/s\n"
+                  << "strategy time, summed over threads (calls, progress, ms):\n";
+
+        for (std::size_t i = 0; i < options.strategies.size(); ++i)
+        {
+            std::cerr << "  " << options.strategies[i]
+                      << ": " << statistics[i].callCount
+                      << ", " << statistics[i].progressCount
+                      << ", " << (static_cast<double>(statistics[i].nanoseconds) / 1e6) << '\n';
+        }
+
+        return 0;
+    }
+
+    std::size_t firstLineLength(std::string_view text)
+    {
+        auto const lineBegin = text.find_first_not_of("\r\n");
+        if (lineBegin == std::string_view::npos)
+        {
+            return 0;
+        }
+
+        auto const lineEnd = text.find_first_of("\r\n", lineBegin);
+        return ((lineEnd == std::string_view::npos) ? text.size() : lineEnd) - lineBegin;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::optional<Options> const options = parseArguments(argc, argv);
+    if (!options)
+    {
+        printUsage();
+        return 2;
+    }
+
+    try
+    {
+        MappedFile input;
+        std::string standardInput;
+        std::string_view text;
+        if (options->inputPath)
+        {
+            input = MappedFile::openForReading(*options->inputPath);
+            text = { input.bytes().data(), input.bytes().size() };
+        }
+        else
+        {
+            standardInput.assign(std::istreambuf_iterator<char>{ std::cin }, std::istreambuf_iterator<char>{});
+            text = standardInput;
+        }
+
+        switch (firstLineLength(text))
+        {
+        case Sudoku4::cellCount:
+            return run<Sudoku4>(text, *options);
+        case Sudoku<3, 2>::cellCount:
+            return run<Sudoku<3, 2>>(text, *options);
+        case Sudoku9::cellCount:
+            return run<Sudoku9>(text, *options);
+        case Sudoku<4, 4>::cellCount:
+            return run<Sudoku<4, 4>>(text, *options);
+        case Sudoku<5, 5>::cellCount:
+            return run<Sudoku<5, 5>>(text, *options);
+        default:
+            std::cerr << "Cannot guess the grid size from the first line\n";
+            return 2;
+        }
+    }
+    catch (std::exception const& exception)
+    {
+        std::cerr << exception.what() << '\n';
+        return 1;
+    }
+}